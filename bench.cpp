@@ -0,0 +1,375 @@
+/* ---------------------------------------------------------------------- *
+ * bench.cpp
+ *
+ * benchmarks of the triangulation primitives, the breadth first search
+ * kernels and the generation of flip graphs. every benchmark is repeated
+ * several times and the median and percentiles of the running times are
+ * written as json together with the throughput.
+ * ---------------------------------------------------------------------- */
+
+#include "src/options.hpp"
+#include "src/triangulation.hpp"
+#include "src/flipgraph.hpp"
+#include "src/functions.hpp"
+#include "src/flipview.hpp"
+#include "src/profile.hpp"
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cstdint>
+
+/* ---------------------------------------------------------------------- *
+ * constants
+ * ---------------------------------------------------------------------- */
+
+const int DEFAULT_MICRO_N = 50;
+const int DEFAULT_GRAPH_N = 10;
+const int DEFAULT_MIN_N = 6;
+const int DEFAULT_MAX_N = 11;
+const int DEFAULT_REPETITIONS = 11;
+
+// the minimal running time of a sample of a microbenchmark in seconds
+const double MINIMUM_SAMPLE_SECONDS = 0.01;
+
+// the number of random flips that produce the triangulation of the
+// microbenchmarks and the number of codes that are compared
+const int RANDOM_FLIPS = 10000;
+const int COMPARED_CODES = 1024;
+
+/* ---------------------------------------------------------------------- *
+ * measurements
+ * ---------------------------------------------------------------------- */
+
+// the running times of the samples of one benchmark
+struct Measurement {
+    // the name of the benchmark
+    std::string name;
+
+    // the number of vertices of the triangulations
+    int n;
+
+    // the running times of all samples in seconds
+    std::vector<double> seconds;
+
+    // the units of the throughput and the number of operations per sample
+    std::vector<std::string> units;
+    std::vector<double> operations;
+};
+
+// returns the specified percentile of the sorted running times
+static double percentile(const std::vector<double> &sorted, int percent) {
+    int index = (int) ((sorted.size() - 1) * percent / 100);
+    return sorted[index];
+}
+
+static void write_measurement(std::ostream &output_stream, const Measurement &measurement) {
+    std::vector<double> sorted = measurement.seconds;
+    std::sort(sorted.begin(), sorted.end());
+    double median = percentile(sorted, 50);
+
+    output_stream << "    {\"name\": \"" << measurement.name << "\", \"n\": " << measurement.n
+                  << ", \"samples\": " << sorted.size()
+                  << ", \"min_s\": " << sorted.front()
+                  << ", \"p10_s\": " << percentile(sorted, 10)
+                  << ", \"median_s\": " << median
+                  << ", \"p90_s\": " << percentile(sorted, 90)
+                  << ", \"max_s\": " << sorted.back()
+                  << ", \"throughput\": {";
+    for (int i = 0; i < (int) measurement.units.size(); ++i) {
+        if (i > 0) { output_stream << ", "; }
+        output_stream << "\"" << measurement.units[i] << "\": " << measurement.operations[i] / median;
+    }
+    output_stream << "}}";
+}
+
+/* ---------------------------------------------------------------------- *
+ * microbenchmarks
+ * ---------------------------------------------------------------------- */
+
+// the data of the microbenchmarks
+struct BenchmarkState {
+    // a random triangulation and its code
+    Triangulation *triangulation;
+    Code *code;
+
+    // flippable representative halfedges of the triangulation
+    std::vector<int> flippable;
+
+    // codes of consecutive triangulations of a random walk
+    std::vector<Code> codes;
+
+    // a flip graph for the breadth first search kernels in compressed
+    // sparse row format
+    ExplicitFlipGraph *view;
+
+    // the sum of the results that keeps the compiler from removing work
+    uint64_t sink;
+};
+
+// a kernel performs the specified number of iterations of a benchmark
+typedef void (*Kernel)(BenchmarkState &state, long iterations);
+
+static void flip_kernel(BenchmarkState &state, long iterations) {
+    Triangulation &triangulation = *state.triangulation;
+    int size = (int) state.flippable.size();
+    for (long i = 0; i < iterations; ++i) {
+        // flipping twice restores the triangulation
+        Halfedge *halfedge = triangulation.halfedge(state.flippable[i % size]);
+        triangulation.flip(halfedge);
+        triangulation.flip(halfedge);
+    }
+}
+
+static void is_flippable_kernel(BenchmarkState &state, long iterations) {
+    Triangulation &triangulation = *state.triangulation;
+    int m = triangulation.size();
+    for (long i = 0; i < iterations; ++i) {
+        for (int j = 0; j < m; ++j) {
+            state.sink += triangulation.is_flippable(triangulation.halfedge(j));
+        }
+    }
+}
+
+static void copy_kernel(BenchmarkState &state, long iterations) {
+    for (long i = 0; i < iterations; ++i) {
+        Triangulation triangulation(*state.triangulation);
+        state.sink += triangulation.size();
+    }
+}
+
+static void code_kernel(BenchmarkState &state, long iterations) {
+    for (long i = 0; i < iterations; ++i) {
+        Code code(*state.triangulation);
+        state.sink += code.symbol(code.length() - 1);
+    }
+}
+
+static void build_from_code_kernel(BenchmarkState &state, long iterations) {
+    for (long i = 0; i < iterations; ++i) {
+        Triangulation triangulation(*state.code);
+        state.sink += triangulation.size();
+    }
+}
+
+static void compare_kernel(BenchmarkState &state, long iterations) {
+    int size = (int) state.codes.size();
+    for (long i = 0; i < iterations; ++i) {
+        int j = (int) (i % (size - 1));
+        state.sink += state.codes[j] < state.codes[j + 1];
+    }
+}
+
+static void distance_list_kernel(BenchmarkState &state, long iterations) {
+    ExplicitFlipGraph &view = *state.view;
+    std::vector<int> sources(1);
+    std::vector<int> distances;
+    for (long i = 0; i < iterations; ++i) {
+        sources[0] = (int) (i % view.size());
+        distance_list(view, sources, distances);
+        state.sink += distances.back();
+    }
+}
+
+static void distance_kernel(BenchmarkState &state, long iterations) {
+    ExplicitFlipGraph &view = *state.view;
+    int size = view.size();
+    for (long i = 0; i < iterations; ++i) {
+        state.sink += bidirectional_distance(view, (int) (i % size), (int) ((i * 7919 + size / 2) % size));
+    }
+}
+
+static void eccentricity_kernel(BenchmarkState &state, long iterations) {
+    ExplicitFlipGraph &view = *state.view;
+    for (long i = 0; i < iterations; ++i) {
+        state.sink += eccentricity(view, (int) (i % view.size()));
+    }
+}
+
+// runs the kernel with a number of iterations that takes at least the
+// minimal sample time and then measures the specified number of samples
+static Measurement measure(const std::string &name, int n, Kernel kernel, BenchmarkState &state,
+                           int repetitions, const std::string &unit, double operations_per_iteration) {
+    long iterations = 1;
+    while (true) {
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+        kernel(state, iterations);
+        if (seconds_since(start_time) >= MINIMUM_SAMPLE_SECONDS) { break; }
+        iterations *= 2;
+    }
+
+    Measurement measurement;
+    measurement.name = name;
+    measurement.n = n;
+    measurement.units.push_back(unit);
+    measurement.operations.push_back(iterations * operations_per_iteration);
+    for (int i = 0; i < repetitions; ++i) {
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+        kernel(state, iterations);
+        measurement.seconds.push_back(seconds_since(start_time));
+    }
+    return measurement;
+}
+
+static void micro_benchmarks(int micro_n, int graph_n, int repetitions, std::vector<Measurement> &measurements) {
+    // random triangulation by random flips from the canonical triangulation
+    std::mt19937_64 generator(micro_n);
+    Triangulation triangulation(micro_n);
+    int m = triangulation.size();
+    for (int i = 0; i < RANDOM_FLIPS; ++i) {
+        Halfedge *halfedge = triangulation.halfedge((int) (generator() % m));
+        if (triangulation.is_flippable(halfedge)) { triangulation.flip(halfedge); }
+    }
+    Code code(triangulation);
+
+    BenchmarkState state;
+    state.triangulation = &triangulation;
+    state.code = &code;
+    state.sink = 0;
+    for (int i = 0; i < m; ++i) {
+        Halfedge *halfedge = triangulation.halfedge(i);
+        if (triangulation.is_representative(halfedge) && triangulation.is_flippable(halfedge)) {
+            state.flippable.push_back(i);
+        }
+    }
+
+    // codes of a random walk differ by one flip, so they share long prefixes
+    Triangulation walk(triangulation);
+    while ((int) state.codes.size() < COMPARED_CODES) {
+        Halfedge *halfedge = walk.halfedge((int) (generator() % m));
+        if (!walk.is_flippable(halfedge)) { continue; }
+        walk.flip(halfedge);
+        state.codes.push_back(Code(walk));
+    }
+
+    FlipGraph flip_graph;
+    flip_graph.compute(graph_n, false);
+    ExplicitFlipGraph view(flip_graph.graph());
+    state.view = &view;
+    double edges = 0;
+    for (const std::vector<int> &neighbors : flip_graph.graph()) { edges += neighbors.size(); }
+
+    measurements.push_back(measure("flip", micro_n, flip_kernel, state, repetitions, "flips/s", 2));
+    measurements.push_back(measure("is_flippable", micro_n, is_flippable_kernel, state, repetitions,
+                                   "halfedges/s", m));
+    measurements.push_back(measure("copy", micro_n, copy_kernel, state, repetitions, "copies/s", 1));
+    measurements.push_back(measure("code", micro_n, code_kernel, state, repetitions, "codes/s", 1));
+    measurements.push_back(measure("build_from_code", micro_n, build_from_code_kernel, state, repetitions,
+                                   "triangulations/s", 1));
+    measurements.push_back(measure("code_compare", micro_n, compare_kernel, state, repetitions,
+                                   "comparisons/s", 1));
+    measurements.push_back(measure("distance_list", graph_n, distance_list_kernel, state, repetitions,
+                                   "edges/s", edges));
+    measurements.push_back(measure("distance", graph_n, distance_kernel, state, repetitions, "queries/s", 1));
+    measurements.push_back(measure("eccentricity", graph_n, eccentricity_kernel, state, repetitions,
+                                   "edges/s", edges));
+
+    if (state.sink == 1) { std::cerr << std::endl; }
+}
+
+/* ---------------------------------------------------------------------- *
+ * end-to-end benchmarks
+ * ---------------------------------------------------------------------- */
+
+static void generation_benchmarks(int min_n, int max_n, int repetitions, std::vector<Measurement> &measurements) {
+    for (int n = min_n; n <= max_n; ++n) {
+        Measurement generation;
+        generation.name = "generate";
+        generation.n = n;
+        Measurement diameter;
+        diameter.name = "diameter";
+        diameter.n = n;
+
+        double codes = 0;
+        double edges = 0;
+        for (int i = 0; i < repetitions; ++i) {
+            std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+            FlipGraph flip_graph;
+            flip_graph.compute(n);
+            generation.seconds.push_back(seconds_since(start_time));
+
+            const FlipGraph::Graph &graph = flip_graph.graph();
+            codes = (double) graph.size();
+            edges = 0;
+            for (const std::vector<int> &neighbors : graph) { edges += neighbors.size(); }
+
+            start_time = std::chrono::steady_clock::now();
+            ExplicitFlipGraph view(graph);
+            graph_diameter(view);
+            diameter.seconds.push_back(seconds_since(start_time));
+        }
+
+        generation.units.push_back("codes/s");
+        generation.operations.push_back(codes);
+        generation.units.push_back("edges/s");
+        generation.operations.push_back(edges);
+        diameter.units.push_back("edges/s");
+        diameter.operations.push_back(codes * edges);
+        measurements.push_back(generation);
+        measurements.push_back(diameter);
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * main function
+ * ---------------------------------------------------------------------- */
+
+int main(int argc, char *argv[]) {
+    char *option_micro_n = get_cmd_option(argc, argv, "--micro-n");
+    char *option_graph_n = get_cmd_option(argc, argv, "--graph-n");
+    char *option_min_n = get_cmd_option(argc, argv, "--min-n");
+    char *option_max_n = get_cmd_option(argc, argv, "--max-n");
+    char *option_repetitions = get_cmd_option(argc, argv, "--repetitions");
+    char *option_output = get_cmd_option(argc, argv, "-o");
+    bool micro_only = cmd_option_exists(argc, argv, "--micro");
+    bool generation_only = cmd_option_exists(argc, argv, "--generation");
+
+    int micro_n = (option_micro_n) ? std::stoi(option_micro_n) : DEFAULT_MICRO_N;
+    int graph_n = (option_graph_n) ? std::stoi(option_graph_n) : DEFAULT_GRAPH_N;
+    int min_n = (option_min_n) ? std::stoi(option_min_n) : DEFAULT_MIN_N;
+    int max_n = (option_max_n) ? std::stoi(option_max_n) : DEFAULT_MAX_N;
+    int repetitions = (option_repetitions) ? std::stoi(option_repetitions) : DEFAULT_REPETITIONS;
+
+    if (micro_n < 4 || graph_n < 4 || min_n < 4 || repetitions < 1) {
+        std::cerr << "error: invalid parameters" << std::endl;
+        return 1;
+    }
+
+    std::vector<Measurement> measurements;
+    if (!generation_only) { micro_benchmarks(micro_n, graph_n, repetitions, measurements); }
+    if (!micro_only) { generation_benchmarks(min_n, max_n, repetitions, measurements); }
+
+    std::ofstream output_file;
+    if (option_output) {
+        output_file.open(option_output);
+        if (!output_file) {
+            std::cerr << "error: cannot open " << option_output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream &output_stream = (option_output) ? output_file : std::cout;
+
+#ifdef NDEBUG
+    bool checks = false;
+#else
+    bool checks = true;
+#endif
+    output_stream << "{\n  \"repetitions\": " << repetitions
+                  << ",\n  \"checks\": " << (checks ? "true" : "false")
+                  << ",\n  \"benchmarks\": [\n";
+    for (int i = 0; i < (int) measurements.size(); ++i) {
+        write_measurement(output_stream, measurements[i]);
+        output_stream << ((i + 1 < (int) measurements.size()) ? ",\n" : "\n");
+    }
+    output_stream << "  ]\n}" << std::endl;
+
+    return 0;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
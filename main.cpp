@@ -6,12 +6,29 @@
 #include "src/flipgraph.hpp"
 #include "src/triangulation.hpp"
 #include "src/functions.hpp"
+#include "src/codeio.hpp"
+#include "src/plantri.hpp"
+#include "src/codeindex.hpp"
+#include "src/flipview.hpp"
+#include "src/query.hpp"
+#include "src/search.hpp"
+#include "src/sampler.hpp"
+#include "src/estimate.hpp"
+#include "src/spectral.hpp"
+#include "src/twocenter.hpp"
+#include "src/profile.hpp"
+#include "src/progress.hpp"
+#include "src/memory.hpp"
+#include "src/polygon.hpp"
+#include "src/labeled.hpp"
 
 #include <vector>
 #include <iostream>
 #include <fstream>
 #include <ctime>
+#include <chrono>
 #include <cassert>
+#include <cstring>
 
 // #define NDEBUG
 
@@ -22,17 +39,45 @@
 const int MODE_GENERATE = 0;
 const int MODE_DIAMETER = 1;
 const int MODE_TRIANGULATION = 2;
+const int MODE_CODES = 3;
+const int MODE_PLANTRI = 4;
+const int MODE_INDEX = 5;
+const int MODE_QUERY = 6;
+const int MODE_DISTANCE = 7;
+const int MODE_PATH = 8;
+const int MODE_SAMPLE = 9;
+const int MODE_ESTIMATE = 10;
+const int MODE_BALL = 11;
+const int MODE_SPECTRUM = 12;
+const int MODE_TWO_CENTER = 13;
+const int MODE_MEMORY = 14;
+const int MODE_LABELED = 15;
 const int MODE_TEST = 99;
 const int DEFAULT_MODE = MODE_GENERATE;
 
 const int FORMAT_PLAIN = 0;
 const int FORMAT_CODE = 1;
 const int FORMAT_DOT = 2;
+const int FORMAT_BINARY = 3;
+const int FORMAT_PLANAR = 4;
 const int DEFAULT_FORMAT = FORMAT_PLAIN;
 
 const int MINIMUM_N = 4;
 const int DEFAULT_N = 4;
 const int DEFAULT_INDEX = 1;
+const int DEFAULT_THREADS = 1;
+const int DEFAULT_SAMPLES = 1;
+const long DEFAULT_BURN_IN = 100000;
+const long DEFAULT_SPACING = 10000;
+const int DEFAULT_RADIUS = 1;
+const int DEFAULT_EIGENVALUES = 5;
+const int DEFAULT_ITERATIONS = 100;
+const double DEFAULT_PROGRESS_INTERVAL = 10;
+
+const int ALGORITHM_BIDIRECTIONAL = 0;
+const int ALGORITHM_ASTAR = 1;
+const int ALGORITHM_IDASTAR = 2;
+const int DEFAULT_ALGORITHM = ALGORITHM_BIDIRECTIONAL;
 
 /* ---------------------------------------------------------------------- *
  * main function
@@ -49,6 +94,32 @@ int main(int argc, char *argv[]) {
             mode = MODE_DIAMETER;
         } else if (strcmp(option_m, "triangulation") == 0) {
             mode = MODE_TRIANGULATION;
+        } else if (strcmp(option_m, "codes") == 0) {
+            mode = MODE_CODES;
+        } else if (strcmp(option_m, "plantri") == 0) {
+            mode = MODE_PLANTRI;
+        } else if (strcmp(option_m, "index") == 0) {
+            mode = MODE_INDEX;
+        } else if (strcmp(option_m, "query") == 0) {
+            mode = MODE_QUERY;
+        } else if (strcmp(option_m, "distance") == 0) {
+            mode = MODE_DISTANCE;
+        } else if (strcmp(option_m, "path") == 0) {
+            mode = MODE_PATH;
+        } else if (strcmp(option_m, "sample") == 0) {
+            mode = MODE_SAMPLE;
+        } else if (strcmp(option_m, "estimate") == 0) {
+            mode = MODE_ESTIMATE;
+        } else if (strcmp(option_m, "ball") == 0) {
+            mode = MODE_BALL;
+        } else if (strcmp(option_m, "spectrum") == 0) {
+            mode = MODE_SPECTRUM;
+        } else if (strcmp(option_m, "two-center") == 0) {
+            mode = MODE_TWO_CENTER;
+        } else if (strcmp(option_m, "memory") == 0) {
+            mode = MODE_MEMORY;
+        } else if (strcmp(option_m, "labeled") == 0) {
+            mode = MODE_LABELED;
         } else if (strcmp(option_m, "test") == 0) {
             mode = MODE_TEST;
         }
@@ -59,6 +130,26 @@ int main(int argc, char *argv[]) {
     int n = (option_n) ? std::stoi(option_n) : DEFAULT_N;
     assert(n >= MINIMUM_N);
 
+    // option --class: class of the triangulations, planar (triangulations of
+    // the sphere) or outerplanar (triangulated polygons)
+    char *option_class = get_cmd_option(argc, argv, "--class");
+    int triangulation_class = CLASS_PLANAR;
+    if (option_class) {
+        if (strcmp(option_class, "planar") == 0) {
+            triangulation_class = CLASS_PLANAR;
+        } else if (strcmp(option_class, "outerplanar") == 0) {
+            triangulation_class = CLASS_OUTERPLANAR;
+        } else {
+            std::cerr << "invalid class " << option_class << std::endl;
+            return 1;
+        }
+    }
+    if (triangulation_class != CLASS_PLANAR
+        && (mode == MODE_SAMPLE || mode == MODE_ESTIMATE || mode == MODE_MEMORY || mode == MODE_LABELED)) {
+        std::cerr << "mode only supports planar triangulations" << std::endl;
+        return 1;
+    }
+
     // option -i: index
     char *option_i = get_cmd_option(argc, argv, "-i");
     int index = (option_i) ? std::stoi(option_i) : DEFAULT_INDEX;
@@ -72,7 +163,7 @@ int main(int argc, char *argv[]) {
     std::ofstream file_stream;
     if (option_o) {
         file_output = true;
-        file_stream.open(option_o);
+        file_stream.open(option_o, std::ios::out | std::ios::binary);
     }
     std::ostream &output_stream = file_output ? file_stream : std::cout;
 
@@ -86,30 +177,207 @@ int main(int argc, char *argv[]) {
             format = FORMAT_CODE;
         } else if (strcmp(option_f, "dot") == 0) {
             format = FORMAT_DOT;
+        } else if (strcmp(option_f, "binary") == 0) {
+            format = FORMAT_BINARY;
+        } else if (strcmp(option_f, "planar") == 0) {
+            format = FORMAT_PLANAR;
         }
     }
 
     // option -t: show elapsed time
     bool show_time = cmd_option_exists(argc, argv, "-t");
 
-    // compute flip graph
-    clock_t start_time = clock();
+    // option --stats: write a json report of the phases of the run to the
+    // standard error, with hardware counters if --counters is given
+    bool show_stats = cmd_option_exists(argc, argv, "--stats");
+    bool hardware_counters = cmd_option_exists(argc, argv, "--counters");
+
+    // option --progress: report the state of the generation periodically to
+    // the standard error or to the file given by --progress-file
+    bool show_progress = cmd_option_exists(argc, argv, "--progress");
+    char *option_progress_interval = get_cmd_option(argc, argv, "--progress-interval");
+    double progress_interval = (option_progress_interval) ? std::stod(option_progress_interval)
+                                                          : DEFAULT_PROGRESS_INTERVAL;
+    char *option_progress_file = get_cmd_option(argc, argv, "--progress-file");
+    std::ofstream progress_file;
+    if (option_progress_file) {
+        show_progress = true;
+        progress_file.open(option_progress_file, std::ios::out | std::ios::app);
+    }
+    Progress progress(option_progress_file ? progress_file : std::cerr, progress_interval);
+
+    // option --memory-limit: bytes (with suffix K, M or G) the data
+    // structures of the generation may use before it degrades
+    char *option_memory_limit = get_cmd_option(argc, argv, "--memory-limit");
+    long memory_limit = (option_memory_limit) ? parse_bytes(option_memory_limit) : 0;
+    if (memory_limit < 0) {
+        std::cerr << "invalid memory limit " << option_memory_limit << std::endl;
+        return 1;
+    }
+
+    // option -j: number of threads
+    char *option_j = get_cmd_option(argc, argv, "-j");
+    int threads = (option_j) ? std::stoi(option_j) : DEFAULT_THREADS;
+    assert(threads >= 1);
+
+    // option --algorithm: flip distance algorithm
+    char *option_algorithm = get_cmd_option(argc, argv, "--algorithm");
+    int algorithm = DEFAULT_ALGORITHM;
+    if (option_algorithm) {
+        if (strcmp(option_algorithm, "bidirectional") == 0) {
+            algorithm = ALGORITHM_BIDIRECTIONAL;
+        } else if (strcmp(option_algorithm, "astar") == 0) {
+            algorithm = ALGORITHM_ASTAR;
+        } else if (strcmp(option_algorithm, "idastar") == 0) {
+            algorithm = ALGORITHM_IDASTAR;
+        }
+    }
+
+    // options for sampling: number of walkers (one per thread by default),
+    // samples per walker, steps before and between samples, random seed and
+    // uniform distribution on unlabeled triangulations
+    char *option_walkers = get_cmd_option(argc, argv, "--walkers");
+    int walkers = (option_walkers) ? std::stoi(option_walkers) : threads;
+    char *option_samples = get_cmd_option(argc, argv, "--samples");
+    int samples = (option_samples) ? std::stoi(option_samples) : DEFAULT_SAMPLES;
+    char *option_burn_in = get_cmd_option(argc, argv, "--burn-in");
+    long burn_in = (option_burn_in) ? std::stol(option_burn_in) : DEFAULT_BURN_IN;
+    char *option_spacing = get_cmd_option(argc, argv, "--spacing");
+    long spacing = (option_spacing) ? std::stol(option_spacing) : DEFAULT_SPACING;
+    char *option_seed = get_cmd_option(argc, argv, "--seed");
+    uint64_t seed = (option_seed) ? std::stoull(option_seed) : (uint64_t) time(nullptr);
+    bool unlabeled = cmd_option_exists(argc, argv, "--unlabeled");
+
+    // option --radius: radius of the explored ball
+    char *option_radius = get_cmd_option(argc, argv, "--radius");
+    int radius = (option_radius) ? std::stoi(option_radius) : DEFAULT_RADIUS;
+    assert(radius >= 0);
+
+    // options for the spectrum: number of eigenvalues, number of lanczos
+    // iterations and lazy random walk
+    char *option_eigenvalues = get_cmd_option(argc, argv, "--eigenvalues");
+    int eigenvalue_count = (option_eigenvalues) ? std::stoi(option_eigenvalues) : DEFAULT_EIGENVALUES;
+    char *option_iterations = get_cmd_option(argc, argv, "--iterations");
+    int iterations = (option_iterations) ? std::stoi(option_iterations) : DEFAULT_ITERATIONS;
+    bool lazy = cmd_option_exists(argc, argv, "--lazy");
+
+    // option --explicit: search the labeled flip graph explicitly instead of
+    // counting labelings of the unlabeled triangulations
+    bool explicit_labeled = cmd_option_exists(argc, argv, "--explicit");
+
+    // option --graph: flip graph file
+    char *option_graph = get_cmd_option(argc, argv, "--graph");
+
+    // option --index: code index file
+    char *option_index = get_cmd_option(argc, argv, "--index");
+
+    // option --socket: unix socket for queries
+    char *option_socket = get_cmd_option(argc, argv, "--socket");
+
+    // option --compact: rebuild codes on demand instead of storing them
+    // (only for modes that access single codes)
+    bool compact = cmd_option_exists(argc, argv, "--compact")
+                   && (mode == MODE_DIAMETER || mode == MODE_TRIANGULATION || mode == MODE_PATH
+                       || (mode == MODE_GENERATE && format != FORMAT_BINARY));
+
+    // modes that work on single triangulations do not need the flip graph
+    bool local_mode = (mode == MODE_DISTANCE || mode == MODE_SAMPLE || mode == MODE_ESTIMATE
+                       || mode == MODE_BALL || mode == MODE_MEMORY || (mode == MODE_LABELED && explicit_labeled));
+
+    // modes that do not need the codes of all triangulations, which may be
+    // dropped if the memory limit is reached
+    bool codes_optional = (mode == MODE_DIAMETER || mode == MODE_TRIANGULATION || mode == MODE_PATH
+                           || (mode == MODE_GENERATE && format != FORMAT_BINARY) || mode == MODE_SPECTRUM
+                           || mode == MODE_TWO_CENTER);
+
+    // triangulated polygons are generated by flipping diagonals directly
+    bool polygons = (triangulation_class == CLASS_OUTERPLANAR && n <= MAX_POLYGON_ORDER);
+
+    // warn if the estimated memory exceeds the limit
+    if (memory_limit > 0 && !local_mode && !option_graph && n <= MAX_CODE_ORDER
+        && triangulation_class == CLASS_PLANAR) {
+        MemoryUsage estimate;
+        estimate_memory(n, estimate);
+        if (estimate.total() > memory_limit) {
+            std::cerr << "estimated memory of " << estimate.total() << " bytes exceeds the limit, "
+                      << "the generation will degrade or fail" << std::endl;
+        }
+    }
+
+    // phases of the run that are reported with --stats
+    Profile profile(show_stats && hardware_counters);
+    int total_phase = profile.phase("total");
+    int generation_phase = profile.phase((option_graph && !local_mode) ? "load" : "generation");
+    int analysis_phase = profile.phase("analysis");
+    int output_phase = profile.phase("output");
+    profile.begin(total_phase);
+
+    // compute or load flip graph
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
     FlipGraph flip_graph;
-    flip_graph.compute(n);
-    clock_t end_time = clock();
+    if (!local_mode) { profile.begin(generation_phase); }
+    if (local_mode) {
+        // nothing to do
+    } else if (option_graph) {
+        std::ifstream graph_stream(option_graph, std::ios::in | std::ios::binary);
+        if (!flip_graph.read_binary(graph_stream)) {
+            std::cerr << "invalid flip graph file " << option_graph << std::endl;
+            return 1;
+        }
+        if (compact && flip_graph.has_parents()) { flip_graph.drop_codes(); }
+    } else {
+        flip_graph.set_memory_limit(memory_limit);
+        flip_graph.set_triangulation_class(triangulation_class);
+        bool complete;
+        if (polygons) {
+            // the codes of the polygons are rebuilt from the search tree on
+            // demand unless the mode needs all of them
+            complete = flip_graph.compute_polygons(n, !codes_optional, show_stats ? &profile : nullptr,
+                                                   show_progress ? &progress : nullptr);
+        } else {
+            complete = flip_graph.compute(n, !compact, show_stats ? &profile : nullptr,
+                                          show_progress ? &progress : nullptr);
+        }
+        if (!complete) {
+            std::cerr << "memory limit of " << memory_limit << " bytes exceeded" << std::endl;
+            return 1;
+        }
+        if (!compact && !flip_graph.stores_codes() && !codes_optional) {
+            std::cerr << "memory limit of " << memory_limit << " bytes reached, codes were dropped" << std::endl;
+            return 1;
+        }
 
-    if (show_time) {
-        double elapsed = double(end_time - start_time) / CLOCKS_PER_SEC;
+        const MemoryUsage &usage = flip_graph.memory_usage();
+        profile.set_value("memory_graph", usage.graph);
+        profile.set_value("memory_codes", usage.codes);
+        profile.set_value("memory_parents", usage.parents);
+        profile.set_value("memory_indices", usage.indices);
+        profile.set_value("memory_queue", usage.queue);
+        profile.set_value("memory_total", usage.total());
+    }
+    profile.end(generation_phase);
+
+    if (show_time && !local_mode) {
+        double elapsed = seconds_since(start_time);
         std::cout << "flip graph generated in " << elapsed << "s" << std::endl;
     }
 
+    profile.begin(analysis_phase);
     switch (mode) {
         case MODE_GENERATE: {
-            flip_graph.write_to_stream(output_stream);
+            profile.end(analysis_phase);
+            profile.begin(output_phase);
+            if (format == FORMAT_BINARY) {
+                flip_graph.write_binary(output_stream);
+            } else {
+                flip_graph.write_to_stream(output_stream);
+            }
             break;
         }
         case MODE_DIAMETER: {
             int diameter = graph_diameter(flip_graph.graph());
+            profile.end(analysis_phase);
+            profile.begin(output_phase);
             output_stream << diameter << std::endl;
             break;
         }
@@ -118,6 +386,8 @@ int main(int argc, char *argv[]) {
             int i = reverse ? size - index : index - 1;
             assert(i >= 0 && i < size);
             Code code = flip_graph.code(i);
+            profile.end(analysis_phase);
+            profile.begin(output_phase);
             if (format == FORMAT_DOT) {
                 Triangulation triangulation(code);
                 triangulation.write_to_stream(output_stream);
@@ -126,6 +396,357 @@ int main(int argc, char *argv[]) {
             }
             break;
         }
+        case MODE_CODES: {
+            profile.end(analysis_phase);
+            profile.begin(output_phase);
+            if (format == FORMAT_BINARY) {
+                write_codes_binary(output_stream, flip_graph.codes());
+            } else {
+                write_codes_text(output_stream, flip_graph.codes());
+            }
+            break;
+        }
+        case MODE_PLANTRI: {
+            CodeIndex code_index;
+            code_index.build(flip_graph.codes());
+
+            // canonically re-encode triangulations read from stdin
+            PlanarCodeReader reader(std::cin);
+            PlanarCodeWriter writer(output_stream);
+            Triangulation *triangulation;
+            while ((triangulation = reader.next()) != nullptr) {
+                Code code(*triangulation);
+                delete triangulation;
+                if (format == FORMAT_PLANAR) {
+                    Triangulation canonical(code);
+                    writer.write(canonical);
+                } else if (format == FORMAT_CODE) {
+                    code.write_to_stream(output_stream);
+                } else {
+                    output_stream << code_index.lookup(code) << '\n';
+                }
+            }
+            if (reader.failed()) {
+                std::cerr << "invalid planar code record " << reader.records() << std::endl;
+                return 1;
+            }
+            break;
+        }
+        case MODE_INDEX: {
+            CodeIndex code_index;
+            code_index.build(flip_graph.codes());
+            profile.end(analysis_phase);
+            profile.begin(output_phase);
+            code_index.write_to_stream(output_stream);
+            break;
+        }
+        case MODE_QUERY: {
+            CodeIndex code_index;
+            if (option_index) {
+                if (!code_index.open(option_index)) {
+                    std::cerr << "invalid index file " << option_index << std::endl;
+                    return 1;
+                }
+            } else {
+                code_index.build(flip_graph.codes());
+            }
+
+            QueryServer server(flip_graph, code_index);
+            if (option_socket) {
+                if (!server.serve_socket(option_socket)) {
+                    std::cerr << "cannot listen on socket " << option_socket << std::endl;
+                    return 1;
+                }
+            } else {
+                std::ios::sync_with_stdio(false);
+                server.serve(std::cin, output_stream);
+            }
+            break;
+        }
+        case MODE_DISTANCE: {
+            // read source and target from stdin
+            std::vector<Code> codes;
+            if (!read_codes_text(std::cin, codes) || codes.size() != 2) {
+                std::cerr << "expected two codes on the standard input" << std::endl;
+                return 1;
+            }
+            for (Code &code : codes) {
+                if (!canonicalize_code(code)) {
+                    std::cerr << "invalid code on the standard input" << std::endl;
+                    return 1;
+                }
+            }
+
+            std::chrono::steady_clock::time_point search_start_time = std::chrono::steady_clock::now();
+            std::vector<Code> path;
+            SearchStatistics statistics = {0, 0};
+            int distance;
+            if (algorithm == ALGORITHM_ASTAR) {
+                distance = flip_distance_astar(codes[0], codes[1], path, statistics);
+            } else if (algorithm == ALGORITHM_IDASTAR) {
+                distance = flip_distance_idastar(codes[0], codes[1], path, statistics);
+            } else {
+                distance = flip_distance(codes[0], codes[1], path, threads);
+            }
+
+            if (show_time) {
+                double elapsed = seconds_since(search_start_time);
+                std::cout << "flip distance computed in " << elapsed << "s" << std::endl;
+                if (algorithm != ALGORITHM_BIDIRECTIONAL) {
+                    double rate = (statistics.seconds > 0) ? statistics.expanded / statistics.seconds : 0;
+                    std::cout << "expanded " << statistics.expanded << " triangulations in "
+                              << statistics.seconds << "s (" << rate << "/s)" << std::endl;
+                }
+            }
+
+            profile.end(analysis_phase);
+            profile.begin(output_phase);
+            if (format == FORMAT_DOT) {
+                for (const Code &code : path) {
+                    Triangulation triangulation(code);
+                    triangulation.write_to_stream(output_stream);
+                }
+            } else {
+                output_stream << distance << std::endl;
+                if (format == FORMAT_CODE) {
+                    for (const Code &code : path) { code.write_to_stream(output_stream); }
+                }
+            }
+            break;
+        }
+        case MODE_PATH: {
+            int size = (int) flip_graph.graph().size();
+            int i = reverse ? size - index : index - 1;
+            assert(i >= 0 && i < size);
+            if (!flip_graph.has_parents()) {
+                if (option_graph) {
+                    std::cerr << "flip graph file " << option_graph << " contains no parent pointers" << std::endl;
+                } else {
+                    std::cerr << "the flip graph contains no parent pointers" << std::endl;
+                }
+                return 1;
+            }
+
+            // replay the flips from the canonical triangulation
+            std::vector<int> flips;
+            flip_graph.flip_sequence(i, flips);
+            int start_type = canonical_type(flip_graph.triangulation_class());
+            Triangulation triangulation(flip_graph.code(0).symbol(0), start_type);
+            for (int j = 0; j <= (int) flips.size(); ++j) {
+                if (j > 0) {
+                    assert(flips[j - 1] < triangulation.size());
+                    triangulation.flip(triangulation.halfedge(flips[j - 1]));
+                }
+                if (format == FORMAT_DOT) {
+                    triangulation.write_to_stream(output_stream);
+                } else {
+                    Code(triangulation).write_to_stream(output_stream);
+                }
+            }
+            assert(flip_graph.code(i) == Code(triangulation));
+            break;
+        }
+        case MODE_SAMPLE: {
+            SamplerSettings settings;
+            settings.n = n;
+            settings.walkers = walkers;
+            settings.threads = threads;
+            settings.burn_in = burn_in;
+            settings.spacing = spacing;
+            settings.samples = samples;
+            settings.unlabeled = unlabeled;
+            settings.seed = seed;
+            settings.format = SAMPLE_FORMAT_DEGREES;
+            if (unlabeled && n > MAX_CODE_ORDER) {
+                // the automorphisms are counted while minimizing codes
+                std::cerr << "unlabeled sampling is limited to " << MAX_CODE_ORDER << " vertices" << std::endl;
+                return 1;
+            }
+            if (format == FORMAT_CODE || format == FORMAT_BINARY) {
+                if (n > MAX_CODE_ORDER) {
+                    std::cerr << "codes are limited to " << MAX_CODE_ORDER << " vertices" << std::endl;
+                    return 1;
+                }
+                settings.format = (format == FORMAT_CODE) ? SAMPLE_FORMAT_CODE : SAMPLE_FORMAT_BINARY;
+            }
+
+            SamplerStatistics statistics;
+            sample_triangulations(settings, output_stream, statistics);
+
+            if (show_time) {
+                double rate = (statistics.seconds > 0) ? statistics.steps / statistics.seconds : 0;
+                std::cerr << statistics.steps << " steps (" << statistics.flips << " flips) in "
+                          << statistics.seconds << "s (" << rate << "/s)" << std::endl;
+            }
+            break;
+        }
+        case MODE_ESTIMATE: {
+            if (n > MAX_CODE_ORDER) {
+                std::cerr << "codes are limited to " << MAX_CODE_ORDER << " vertices" << std::endl;
+                return 1;
+            }
+
+            SamplerSettings settings;
+            settings.n = n;
+            settings.walkers = walkers;
+            settings.threads = threads;
+            settings.burn_in = burn_in;
+            settings.spacing = spacing;
+            settings.samples = samples;
+            settings.unlabeled = false;
+            settings.seed = seed;
+            settings.format = SAMPLE_FORMAT_DEGREES;
+
+            std::chrono::steady_clock::time_point estimate_start_time = std::chrono::steady_clock::now();
+            FlipGraphEstimate estimate;
+            estimate_flip_graph(settings, estimate);
+
+            if (show_time) {
+                double elapsed = seconds_since(estimate_start_time);
+                std::cout << "flip graph estimated from " << estimate.samples << " samples in "
+                          << elapsed << "s" << std::endl;
+            }
+
+            profile.end(analysis_phase);
+            profile.begin(output_phase);
+
+            // one line per layer and a final line for the total size,
+            // each with the half width of the 95% confidence interval
+            for (int i = 0; i < (int) estimate.layers.size(); ++i) {
+                output_stream << i << " " << estimate.layers[i] << " " << estimate.layer_errors[i] << std::endl;
+            }
+            output_stream << "total " << estimate.size << " " << estimate.size_error << std::endl;
+            break;
+        }
+        case MODE_BALL: {
+            // read center from stdin
+            std::vector<Code> codes;
+            if (!read_codes_text(std::cin, codes) || codes.size() != 1) {
+                std::cerr << "expected one code on the standard input" << std::endl;
+                return 1;
+            }
+            if (!canonicalize_code(codes[0])) {
+                std::cerr << "invalid code on the standard input" << std::endl;
+                return 1;
+            }
+
+            // the induced subgraph is only generated if it is written,
+            // otherwise the layers are counted on the implicit flip graph
+            bool subgraph = (format == FORMAT_BINARY || format == FORMAT_CODE);
+            std::vector<long> layers;
+            std::chrono::steady_clock::time_point ball_start_time = std::chrono::steady_clock::now();
+            profile.end(analysis_phase);
+            profile.begin(generation_phase);
+            if (subgraph) {
+                flip_graph.compute(codes[0], radius, threads);
+            } else {
+                ImplicitFlipGraph view;
+                layer_sizes(view, codes[0], radius, layers, threads);
+            }
+            profile.end(generation_phase);
+
+            if (show_time) {
+                double elapsed = seconds_since(ball_start_time);
+                std::cout << "ball explored in " << elapsed << "s" << std::endl;
+            }
+
+            profile.begin(output_phase);
+            if (format == FORMAT_BINARY) {
+                flip_graph.write_binary(output_stream);
+            } else if (format == FORMAT_CODE) {
+                write_codes_text(output_stream, flip_graph.codes());
+            } else {
+                // number of triangulations at each distance from the center
+                for (int i = 0; i < (int) layers.size(); ++i) {
+                    output_stream << i << " " << layers[i] << std::endl;
+                }
+            }
+            break;
+        }
+        case MODE_SPECTRUM: {
+            std::chrono::steady_clock::time_point spectrum_start_time = std::chrono::steady_clock::now();
+            std::vector<double> eigenvalues;
+            top_eigenvalues(flip_graph.graph(), eigenvalue_count, iterations, lazy, threads, eigenvalues);
+
+            if (show_time) {
+                double elapsed = seconds_since(spectrum_start_time);
+                std::cout << "eigenvalues computed in " << elapsed << "s" << std::endl;
+            }
+
+            profile.end(analysis_phase);
+            profile.begin(output_phase);
+            output_stream.precision(12);
+            for (double eigenvalue : eigenvalues) { output_stream << eigenvalue << std::endl; }
+            break;
+        }
+        case MODE_TWO_CENTER: {
+            std::chrono::steady_clock::time_point bounds_start_time = std::chrono::steady_clock::now();
+            std::vector<long> histogram;
+            if (!two_center_histogram(flip_graph.graph(), threads, histogram)) {
+                std::cerr << "flip graph is not connected or its diameter is too large" << std::endl;
+                return 1;
+            }
+
+            if (show_time) {
+                double elapsed = seconds_since(bounds_start_time);
+                std::cout << "two center bounds computed in " << elapsed << "s" << std::endl;
+            }
+
+            profile.end(analysis_phase);
+            profile.begin(output_phase);
+
+            // number of center pairs for every bound
+            for (long count : histogram) { output_stream << count << " "; }
+            output_stream << std::endl;
+            break;
+        }
+        case MODE_MEMORY: {
+            if (n > MAX_CODE_ORDER) {
+                std::cerr << "codes are limited to " << MAX_CODE_ORDER << " vertices" << std::endl;
+                return 1;
+            }
+
+            // estimated bytes per data structure of the generation
+            MemoryUsage estimate;
+            estimate_memory(n, estimate);
+            profile.end(analysis_phase);
+            profile.begin(output_phase);
+            output_stream << "graph " << estimate.graph << std::endl;
+            output_stream << "codes " << estimate.codes << std::endl;
+            output_stream << "parents " << estimate.parents << std::endl;
+            output_stream << "indices " << estimate.indices << std::endl;
+            output_stream << "queue " << estimate.queue << std::endl;
+            output_stream << "total " << estimate.total() << std::endl;
+            break;
+        }
+        case MODE_LABELED: {
+            LabeledCounts counts;
+            std::vector<uint64_t> layers;
+            if (explicit_labeled) {
+                if (n > MAX_LABELED_ORDER) {
+                    std::cerr << "the explicit search is limited to " << MAX_LABELED_ORDER << " vertices"
+                              << std::endl;
+                    return 1;
+                }
+                explore_labeled(n, counts, layers);
+            } else {
+                labeled_counts(flip_graph, counts);
+            }
+            profile.end(analysis_phase);
+            profile.begin(output_phase);
+
+            // number of labeled triangulations at each distance from the
+            // canonical triangulation (only known from the explicit search)
+            for (int i = 0; i < (int) layers.size(); ++i) {
+                output_stream << "layer " << i << " " << layers[i] << std::endl;
+            }
+            output_stream << "triangulations " << counts.triangulations << std::endl;
+            output_stream << "edges " << counts.edges << std::endl;
+            for (int i = 0; i < (int) counts.degrees.size(); ++i) {
+                if (counts.degrees[i] > 0) { output_stream << "degree " << i << " " << counts.degrees[i] << std::endl; }
+            }
+            break;
+        }
         case MODE_TEST: {
             break;
         }
@@ -133,6 +754,11 @@ int main(int argc, char *argv[]) {
 
     // close output stream
     if (file_output) { file_stream.close(); }
+    profile.end(analysis_phase);
+    profile.end(output_phase);
+    profile.end(total_phase);
+
+    if (show_stats) { profile.write_json(std::cerr); }
 
     return 0;
 }
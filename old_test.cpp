@@ -5,6 +5,7 @@
 #include "src/options.hpp"
 #include "src/flipgraph.hpp"
 #include "src/functions.hpp"
+#include "src/distancematrix.hpp"
 
 #include <iostream>
 #include <ctime>
@@ -108,24 +109,27 @@ void double_distance(const Graph &graph) {
     int size = (int) graph.size();
 
     std::vector<int> bounds;
-    std::vector<std::vector<int> > distances(size);
 
     // precompute distances
-    for (int i = 0; i < size; ++i) {
-        distance_list(graph, i, distances[i]);
-    }
+    DistanceMatrix distances;
+    bool valid = distances.compute(graph);
+    assert(valid);
 
     // check all pairs c1 and c2
+    std::vector<unsigned char> row_1;
+    std::vector<unsigned char> row_2;
     for (int c1 = 0; c1 < size; ++c1) {
+        distances.row(c1, row_1);
         for (int c2 = c1; c2 < size; ++c2) {
+            distances.row(c2, row_2);
             // find worst pair for c1 and c2
             int bound = 0;
             for (int ta = 0; ta < size; ++ta) {
                 for (int tb = ta + 1; tb < size; ++tb) {
-                    int d_a1 = distances[ta][c1];
-                    int d_a2 = distances[ta][c2];
-                    int d_b1 = distances[tb][c1];
-                    int d_b2 = distances[tb][c2];
+                    int d_a1 = row_1[ta];
+                    int d_a2 = row_2[ta];
+                    int d_b1 = row_1[tb];
+                    int d_b2 = row_2[tb];
                     int best = std::min(d_a1 + d_b1, d_a2 + d_b2);
                     bound = std::max(bound, best);
                 }
@@ -171,17 +175,19 @@ int main(int argc, char *argv[]) {
 
 
     // precompute distances
-    std::vector<std::vector<int> > distances(size);
-    for (int i = 0; i < size; ++i) {
-        distance_list(flip_graph.graph(), i, distances[i]);
-    }
+    DistanceMatrix distances;
+    bool valid = distances.compute(flip_graph.graph());
+    assert(valid);
 
     int eleven = 0;
     int ten = 0;
 
+    std::vector<unsigned char> row;
     for (int i = 0; i < size; ++i) {
+        distances.row(i, row);
+        std::vector<int> list_i(row.begin(), row.end());
         std::vector<int> histogram;
-        list_to_histogram(distances[i], histogram);
+        list_to_histogram(list_i, histogram);
         int distance = (int) histogram.size() - 1;
         int last = histogram[distance];
         int bound = (last == 1) ? 2 * distance - 1 : 2 * distance;
@@ -191,10 +197,10 @@ int main(int argc, char *argv[]) {
         // triangulations in boundary
         std::vector<int> list;
         for (int k = 0; k < size; ++k) {
-            //assert (distances[i][k] <= 6);
-            assert (distances[i][k] <= 7);
-            //if (distances[i][k] == 6) {
-            if (distances[i][k] == 7) {
+            //assert (row[k] <= 6);
+            assert (row[k] <= 7);
+            //if (row[k] == 6) {
+            if (row[k] == 7) {
                 list.push_back(k);
             }
         }
@@ -205,10 +211,11 @@ int main(int argc, char *argv[]) {
             int five = 0;
             int six = 0;
             for (int k = 0; k < l; ++k) {
-                //if (distances[j][list[k]] == 6) { six++; }
-                if (distances[j][list[k]] == 7) { six++; }
-                //if (distances[j][list[k]] == 5) { five++; }
-                if (distances[j][list[k]] == 6) { five++; }
+                int distance_jk = distances.get(j, list[k]);
+                //if (distance_jk == 6) { six++; }
+                if (distance_jk == 7) { six++; }
+                //if (distance_jk == 5) { five++; }
+                if (distance_jk == 6) { five++; }
             }
             if (six == 1 && five > 0) { eleven++; }
             if (six == 0 && five > 1) { ten++; }
@@ -0,0 +1,103 @@
+/* ---------------------------------------------------------------------- *
+ * arena.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "arena.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+/* ---------------------------------------------------------------------- *
+ * block pool
+ * ---------------------------------------------------------------------- */
+
+// the free blocks of a thread
+class BlockPool {
+public:
+    ~BlockPool() {
+        for (std::pair<char *, std::size_t> &block : blocks) { std::free(block.first); }
+    }
+
+    std::vector<std::pair<char *, std::size_t> > blocks;
+};
+
+static thread_local BlockPool pool;
+
+// returns a block of at least the specified size, preferably from the pool
+// if its size is at most twice the specified size
+static char *acquire_block(std::size_t bytes, std::size_t &size) {
+    std::vector<std::pair<char *, std::size_t> > &blocks = pool.blocks;
+    for (int i = (int) blocks.size() - 1; i >= 0; --i) {
+        if (blocks[i].second >= bytes && blocks[i].second <= 2 * bytes) {
+            char *data = blocks[i].first;
+            size = blocks[i].second;
+            blocks[i] = blocks.back();
+            blocks.pop_back();
+            return data;
+        }
+    }
+
+    size = bytes;
+    char *data = (char *) std::malloc(size);
+    if (data == nullptr) { throw std::bad_alloc(); }
+    return data;
+}
+
+// returns the block to the pool or frees it if the pool is full
+static void return_block(char *data, std::size_t size) {
+    std::vector<std::pair<char *, std::size_t> > &blocks = pool.blocks;
+    if (blocks.size() < ARENA_POOL_SIZE) {
+        blocks.push_back(std::make_pair(data, size));
+    } else {
+        std::free(data);
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the arena class
+ * ---------------------------------------------------------------------- */
+
+Arena::Arena() : position_(nullptr), end_(nullptr) {
+    first_.data = nullptr;
+    first_.size = 0;
+}
+
+Arena::~Arena() {
+    release();
+}
+
+void Arena::add_block(std::size_t bytes) {
+    // blocks grow geometrically
+    std::size_t minimum = ARENA_MINIMUM_BLOCK_SIZE;
+    if (first_.data != nullptr) { minimum = 2 * (blocks_.empty() ? first_.size : blocks_.back().size); }
+    Block block;
+    block.data = acquire_block(std::max(bytes, minimum), block.size);
+    if (first_.data == nullptr) {
+        first_ = block;
+    } else {
+        blocks_.push_back(block);
+    }
+    position_ = block.data;
+    end_ = block.data + block.size;
+}
+
+void Arena::reserve(std::size_t bytes) {
+    if (position_ == nullptr || (std::size_t) (end_ - position_) < bytes) {
+        add_block(bytes + alignof(std::max_align_t));
+    }
+}
+
+void Arena::release() {
+    if (first_.data != nullptr) { return_block(first_.data, first_.size); }
+    for (Block &block : blocks_) { return_block(block.data, block.size); }
+    first_.data = nullptr;
+    first_.size = 0;
+    blocks_.clear();
+    position_ = nullptr;
+    end_ = nullptr;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,91 @@
+/* ---------------------------------------------------------------------- *
+ * arena.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_ARENA__
+#define __FGG_ARENA__
+
+#include <vector>
+#include <cstddef>
+
+/* ---------------------------------------------------------------------- *
+ * constants
+ * ---------------------------------------------------------------------- */
+
+// the smallest block an arena allocates
+const std::size_t ARENA_MINIMUM_BLOCK_SIZE = 1024;
+
+// the number of free blocks every thread keeps for reuse
+const std::size_t ARENA_POOL_SIZE = 64;
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the arena class
+ *
+ * an arena hands out memory from large blocks by advancing a pointer and
+ * frees all of it at once. objects in an arena are never destroyed, hence
+ * it must only hold trivially destructible objects. the blocks of released
+ * arenas are kept in a pool of the releasing thread, from which new blocks
+ * of the same thread are taken first. thus, arenas that are created and
+ * released over and over (e.g., copies of triangulations during a
+ * breadth first search) rarely touch the global heap, and every thread
+ * works on its own blocks.
+ * ---------------------------------------------------------------------- */
+
+class Arena {
+public:
+    // constructor that creates an empty arena
+    Arena();
+
+    // destructor that releases all blocks
+    ~Arena();
+
+    // arenas are not copyable
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+private:
+    // a block of memory
+    struct Block {
+        char *data;
+        std::size_t size;
+    };
+
+    // the first block and all further blocks of this arena (most arenas
+    // only need one block, which is then their only allocation)
+    Block first_;
+    std::vector<Block> blocks_;
+
+    // the free part of the current block
+    char *position_;
+    char *end_;
+
+    // adds a block with at least the specified number of bytes
+    void add_block(std::size_t bytes);
+
+public:
+    // makes sure that the specified number of bytes can be allocated without
+    // a new block
+    void reserve(std::size_t bytes);
+
+    // returns memory for the specified number of bytes with the specified
+    // alignment (a power of two)
+    void *allocate(std::size_t bytes, std::size_t alignment) {
+        std::size_t offset = (std::size_t) (-(std::ptrdiff_t) position_) & (alignment - 1);
+        if (position_ == nullptr || (std::size_t) (end_ - position_) < offset + bytes) {
+            add_block(bytes + alignment);
+            offset = (std::size_t) (-(std::ptrdiff_t) position_) & (alignment - 1);
+        }
+        void *result = position_ + offset;
+        position_ += offset + bytes;
+        return result;
+    }
+
+    // frees all memory of this arena
+    void release();
+};
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
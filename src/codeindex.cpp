@@ -0,0 +1,331 @@
+/* ---------------------------------------------------------------------- *
+ * codeindex.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "codeindex.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include <cassert>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* ---------------------------------------------------------------------- *
+ * constants
+ * ---------------------------------------------------------------------- */
+
+// the magic bytes at the start of an index file
+const char CODE_INDEX_MAGIC[8] = {'F', 'G', 'I', 'N', 'D', 'E', 'X', '1'};
+
+// marker used to detect index files with a different byte order
+const uint32_t CODE_INDEX_BYTE_ORDER = 0x01020304;
+
+// the size of the header of an index file in bytes
+const int CODE_INDEX_HEADER_SIZE = 64;
+
+// the average number of keys per bucket
+const int CODE_INDEX_BUCKET_SIZE = 4;
+
+// the number of first displacements tried before a new seed is chosen
+const uint32_t CODE_INDEX_MAX_DISPLACEMENT = 64;
+
+/* ---------------------------------------------------------------------- *
+ * hash functions
+ * ---------------------------------------------------------------------- */
+
+// mixes the bits of the specified value
+static inline uint64_t mix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+uint64_t hash_symbols(const unsigned char *symbols, int length, uint64_t seed) {
+    uint64_t hash = seed ^ ((uint64_t) length * 0x9e3779b97f4a7c15ULL);
+    int i = 0;
+
+    // process eight symbols at once
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, symbols + i, 8);
+        hash = (hash ^ word) * 0x87c37b91114253d5ULL;
+        hash = (hash << 31) | (hash >> 33);
+    }
+
+    // process remaining symbols
+    uint64_t word = 0;
+    memcpy(&word, symbols + i, length - i);
+    hash = (hash ^ word) * 0x87c37b91114253d5ULL;
+
+    return mix(hash);
+}
+
+std::size_t CodeHash::operator()(const Code &code) const {
+    return (std::size_t) hash_symbols(code.symbols(), code.length(), 0);
+}
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the code index class
+ * ---------------------------------------------------------------------- */
+
+CodeIndex::CodeIndex() : mapping_(nullptr), mapping_size_(0), count_(0), length_(0),
+                         buckets_(0), seed_(0), stride_(0),
+                         displacements_(nullptr), slots_(nullptr) {
+}
+
+CodeIndex::~CodeIndex() {
+    close();
+}
+
+bool CodeIndex::attach(const unsigned char *data, std::size_t size) {
+    if (size < (std::size_t) CODE_INDEX_HEADER_SIZE) { return false; }
+    if (memcmp(data, CODE_INDEX_MAGIC, 8) != 0) { return false; }
+
+    uint32_t length, stride, byte_order;
+    memcpy(&length, data + 12, 4);
+    memcpy(&count_, data + 16, 8);
+    memcpy(&buckets_, data + 24, 8);
+    memcpy(&seed_, data + 32, 8);
+    memcpy(&stride, data + 40, 4);
+    memcpy(&byte_order, data + 44, 4);
+    if (byte_order != CODE_INDEX_BYTE_ORDER) { return false; }
+    length_ = (int) length;
+    stride_ = (int) stride;
+
+    // lookups take the hash modulo the number of buckets, and the sizes
+    // must not overflow the required size
+    if (buckets_ == 0 || buckets_ > size / 8 || stride_ < 4 + length_ || count_ > size / stride_) { return false; }
+    std::size_t required = CODE_INDEX_HEADER_SIZE + 8 * buckets_ + count_ * stride_;
+    if (size < required) { return false; }
+
+    displacements_ = (const uint32_t *) (data + CODE_INDEX_HEADER_SIZE);
+    slots_ = data + CODE_INDEX_HEADER_SIZE + 8 * buckets_;
+    return true;
+}
+
+void CodeIndex::hash(const unsigned char *symbols, uint64_t &bucket, uint64_t &first, uint64_t &second) const {
+    uint64_t hash = hash_symbols(symbols, length_, seed_);
+    bucket = (hash & 0xffffffffULL) % buckets_;
+    first = mix(hash) % count_;
+    second = (hash >> 32) % count_;
+}
+
+bool CodeIndex::build_with_seed(const CodeTable &codes) {
+    uint64_t count = count_;
+    uint64_t buckets = buckets_;
+
+    // compute hash values
+    std::vector<uint32_t> bucket_of(count);
+    std::vector<uint32_t> first(count);
+    std::vector<uint32_t> second(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t bucket, hash_first, hash_second;
+        hash(codes[i].symbols(), bucket, hash_first, hash_second);
+        bucket_of[i] = (uint32_t) bucket;
+        first[i] = (uint32_t) hash_first;
+        second[i] = (uint32_t) hash_second;
+    }
+
+    // group keys by bucket
+    std::vector<uint32_t> start(buckets + 1, 0);
+    for (uint64_t i = 0; i < count; ++i) { start[bucket_of[i] + 1]++; }
+    for (uint64_t b = 0; b < buckets; ++b) { start[b + 1] += start[b]; }
+    std::vector<uint32_t> keys(count);
+    std::vector<uint32_t> position(start.begin(), start.end() - 1);
+    for (uint64_t i = 0; i < count; ++i) { keys[position[bucket_of[i]]++] = (uint32_t) i; }
+
+    // order buckets by decreasing size
+    uint32_t max_size = 0;
+    for (uint64_t b = 0; b < buckets; ++b) { max_size = std::max(max_size, start[b + 1] - start[b]); }
+    std::vector<uint32_t> size_start(max_size + 2, 0);
+    for (uint64_t b = 0; b < buckets; ++b) { size_start[max_size - (start[b + 1] - start[b]) + 1]++; }
+    for (uint32_t s = 0; s <= max_size; ++s) { size_start[s + 1] += size_start[s]; }
+    std::vector<uint32_t> order(buckets);
+    for (uint64_t b = 0; b < buckets; ++b) { order[size_start[max_size - (start[b + 1] - start[b])]++] = (uint32_t) b; }
+
+    // place keys bucket by bucket
+    uint32_t *displacements = (uint32_t *) ((unsigned char *) buffer_.data() + CODE_INDEX_HEADER_SIZE);
+    std::vector<char> taken(count, 0);
+    std::vector<uint32_t> slots(count);
+    std::vector<uint64_t> base(max_size);
+    uint64_t free_slot = 0;
+
+    for (uint64_t j = 0; j < buckets; ++j) {
+        uint32_t bucket = order[j];
+        uint32_t begin = start[bucket];
+        uint32_t size = start[bucket + 1] - begin;
+        if (size == 0) { break; }
+
+        if (size == 1) {
+            // a single key can be moved to any free slot directly
+            uint32_t key = keys[begin];
+            while (taken[free_slot]) { free_slot++; }
+            displacements[2 * bucket] = 0;
+            displacements[2 * bucket + 1] = (uint32_t) ((free_slot + count - first[key]) % count);
+            taken[free_slot] = 1;
+            slots[key] = (uint32_t) free_slot;
+            continue;
+        }
+
+        bool placed = false;
+        for (uint32_t d0 = 0; d0 < CODE_INDEX_MAX_DISPLACEMENT && !placed; ++d0) {
+            // keys of the bucket must not collide among each other
+            bool distinct = true;
+            for (uint32_t k = 0; k < size && distinct; ++k) {
+                uint32_t key = keys[begin + k];
+                base[k] = (first[key] + (uint64_t) d0 * second[key]) % count;
+                for (uint32_t l = 0; l < k; ++l) {
+                    if (base[l] == base[k]) { distinct = false; }
+                }
+            }
+            if (!distinct) { continue; }
+
+            // find displacement that moves all keys to free slots
+            for (uint64_t d1 = 0; d1 < count && !placed; ++d1) {
+                bool free = true;
+                for (uint32_t k = 0; k < size && free; ++k) {
+                    if (taken[(base[k] + d1) % count]) { free = false; }
+                }
+                if (!free) { continue; }
+
+                for (uint32_t k = 0; k < size; ++k) {
+                    uint64_t slot = (base[k] + d1) % count;
+                    taken[slot] = 1;
+                    slots[keys[begin + k]] = (uint32_t) slot;
+                }
+                displacements[2 * bucket] = d0;
+                displacements[2 * bucket + 1] = (uint32_t) d1;
+                placed = true;
+            }
+        }
+
+        if (!placed) { return false; }
+    }
+
+    // fill slots
+    unsigned char *slot_data = (unsigned char *) displacements + 8 * buckets;
+    for (uint64_t i = 0; i < count; ++i) {
+        unsigned char *record = slot_data + (uint64_t) slots[i] * stride_;
+        uint32_t index = (uint32_t) i;
+        memcpy(record, &index, 4);
+        memcpy(record + 4, codes[i].symbols(), length_);
+    }
+
+    return true;
+}
+
+void CodeIndex::close() {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, mapping_size_);
+        mapping_ = nullptr;
+        mapping_size_ = 0;
+    }
+    buffer_.clear();
+    count_ = 0;
+    displacements_ = nullptr;
+    slots_ = nullptr;
+}
+
+void CodeIndex::build(const CodeTable &codes) {
+    close();
+
+    count_ = codes.size();
+    length_ = codes.length();
+    buckets_ = count_ / CODE_INDEX_BUCKET_SIZE + 1;
+    stride_ = (4 + length_ + 3) / 4 * 4;
+
+    // allocate header, displacements and slots
+    std::size_t size = CODE_INDEX_HEADER_SIZE + 8 * buckets_ + count_ * stride_;
+    buffer_.assign((size + 7) / 8, 0);
+    unsigned char *data = (unsigned char *) buffer_.data();
+
+    if (count_ > 0) {
+        for (seed_ = 0; !build_with_seed(codes); ++seed_) {
+            memset(data, 0, size);
+        }
+    }
+
+    // write header
+    uint32_t n = count_ > 0 ? codes[0].symbol(0) : 0;
+    uint32_t length = (uint32_t) length_;
+    uint32_t stride = (uint32_t) stride_;
+    memcpy(data, CODE_INDEX_MAGIC, 8);
+    memcpy(data + 8, &n, 4);
+    memcpy(data + 12, &length, 4);
+    memcpy(data + 16, &count_, 8);
+    memcpy(data + 24, &buckets_, 8);
+    memcpy(data + 32, &seed_, 8);
+    memcpy(data + 40, &stride, 4);
+    memcpy(data + 44, &CODE_INDEX_BYTE_ORDER, 4);
+
+    bool valid = attach(data, size);
+    assert(valid);
+    (void) valid;
+}
+
+bool CodeIndex::open(const char *path) {
+    close();
+
+    int file = ::open(path, O_RDONLY);
+    if (file < 0) { return false; }
+
+    struct stat status;
+    if (fstat(file, &status) != 0 || status.st_size < CODE_INDEX_HEADER_SIZE) {
+        ::close(file);
+        return false;
+    }
+
+    mapping_size_ = (std::size_t) status.st_size;
+    mapping_ = mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, file, 0);
+    ::close(file);
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        mapping_size_ = 0;
+        return false;
+    }
+
+    if (!attach((const unsigned char *) mapping_, mapping_size_)) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+int CodeIndex::size() const {
+    return (int) count_;
+}
+
+int CodeIndex::lookup(const unsigned char *symbols, int length) const {
+    if (count_ == 0 || length != length_) { return -1; }
+
+    uint64_t bucket, first, second;
+    hash(symbols, bucket, first, second);
+    const uint32_t *displacement = displacements_ + 2 * bucket;
+    uint64_t slot = (first + (uint64_t) displacement[0] * second + displacement[1]) % count_;
+
+    const unsigned char *record = slots_ + slot * stride_;
+    if (memcmp(record + 4, symbols, length_) != 0) { return -1; }
+    uint32_t index;
+    memcpy(&index, record, 4);
+    return (int) index;
+}
+
+int CodeIndex::lookup(const Code &code) const {
+    return lookup(code.symbols(), code.length());
+}
+
+void CodeIndex::write_to_stream(std::ostream &output_stream) const {
+    const char *data = (const char *) (mapping_ != nullptr ? mapping_ : (const void *) buffer_.data());
+    std::size_t size = CODE_INDEX_HEADER_SIZE + 8 * buckets_ + count_ * stride_;
+    output_stream.write(data, size);
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,119 @@
+/* ---------------------------------------------------------------------- *
+ * codeindex.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_CODE_INDEX__
+#define __FGG_CODE_INDEX__
+
+#include "triangulation.hpp"
+#include "codetable.hpp"
+
+#include <vector>
+#include <iostream>
+#include <cstddef>
+#include <cstdint>
+
+/* ---------------------------------------------------------------------- *
+ * hash functions
+ * ---------------------------------------------------------------------- */
+
+// computes a 64 bit hash value of the specified symbols
+uint64_t hash_symbols(const unsigned char *symbols, int length, uint64_t seed);
+
+// hash function object for codes, e.g., for unordered maps
+struct CodeHash {
+    std::size_t operator()(const Code &code) const;
+};
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the code index class
+ *
+ * the code index maps codes to their indices in a code list using a
+ * minimal perfect hash function (hash and displace). every bucket of keys
+ * stores a displacement pair and every key is placed in its own slot that
+ * also holds the key's code for verification. a lookup therefore touches
+ * the bucket's displacement pair and a single slot.
+ *
+ * the index can be written to a file and memory mapped, in which case
+ * the file is used as is without any parsing.
+ * ---------------------------------------------------------------------- */
+
+class CodeIndex {
+public:
+    // constructor that creates an empty index
+    CodeIndex();
+
+    // destructor
+    ~CodeIndex();
+
+private:
+    // the index data if it is built in memory (8 byte aligned)
+    std::vector<uint64_t> buffer_;
+
+    // the memory mapped file if the index has been opened from a file
+    void *mapping_;
+
+    // the size of the memory mapped file
+    std::size_t mapping_size_;
+
+    // the number of codes
+    uint64_t count_;
+
+    // the length of the codes
+    int length_;
+
+    // the number of buckets
+    uint64_t buckets_;
+
+    // the seed of the hash function
+    uint64_t seed_;
+
+    // the size of a slot in bytes
+    int stride_;
+
+    // the displacement pairs of the buckets
+    const uint32_t *displacements_;
+
+    // the slots holding the index and the code of every key
+    const unsigned char *slots_;
+
+    // initializes the members from the header of the specified data
+    bool attach(const unsigned char *data, std::size_t size);
+
+    // computes the bucket and the two slot hash values for the specified symbols
+    void hash(const unsigned char *symbols, uint64_t &bucket, uint64_t &first, uint64_t &second) const;
+
+    // tries to build the index with the current seed
+    bool build_with_seed(const CodeTable &codes);
+
+    // releases the index data
+    void close();
+
+public:
+    // builds the index for the specified codes, the i-th code gets index i
+    void build(const CodeTable &codes);
+
+    // memory maps the index file with the specified path. returns false if
+    // the file cannot be opened or is not a valid index file.
+    bool open(const char *path);
+
+    // returns the number of codes in the index
+    int size() const;
+
+    // returns the index of the code with the specified symbols or -1 if the
+    // code is not contained in the index
+    int lookup(const unsigned char *symbols, int length) const;
+
+    // returns the index of the specified code or -1 if the code is not
+    // contained in the index
+    int lookup(const Code &code) const;
+
+    // writes the index to the specified stream
+    void write_to_stream(std::ostream &output_stream) const;
+};
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,283 @@
+/* ---------------------------------------------------------------------- *
+ * codeio.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "codeio.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+
+/* ---------------------------------------------------------------------- *
+ * constants
+ * ---------------------------------------------------------------------- */
+
+// the magic bytes at the start of a binary code file
+const char CODE_FILE_MAGIC[4] = {'F', 'G', 'C', '1'};
+
+// the size of the blocks in which files are read and written
+const int BLOCK_SIZE = 1 << 20;
+
+/* ---------------------------------------------------------------------- *
+ * helper functions
+ * ---------------------------------------------------------------------- */
+
+// stores the specified value as little endian integer with the specified
+// number of bytes
+static void store_integer(char *buffer, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        buffer[i] = (char) ((value >> (8 * i)) & 0xff);
+    }
+}
+
+// loads a little endian integer with the specified number of bytes
+static uint64_t load_integer(const char *buffer, int bytes) {
+    uint64_t value = 0;
+    for (int i = bytes - 1; i >= 0; --i) {
+        value = (value << 8) | (unsigned char) buffer[i];
+    }
+    return value;
+}
+
+// writes the specified code in text format to the buffer and returns the
+// number of characters written. the buffer must have room for
+// code.length() + 4 characters.
+static int format_code(const CodeView &code, char *buffer) {
+    int n = (int) code.symbol(0);
+    int length = 0;
+
+    // write n
+    char digits[4];
+    int count = 0;
+    do {
+        digits[count++] = (char) ('0' + n % 10);
+        n /= 10;
+    } while (n > 0);
+    while (count > 0) { buffer[length++] = digits[--count]; }
+
+    // write adjacency lists
+    n = (int) code.symbol(0);
+    int index = 0;
+    int label = 1;
+    for (int i = 0; i < n; ++i) {
+        buffer[length++] = ' ';
+        while (code.symbol(++index)) {
+            int symbol = code.symbol(index);
+            if (symbol > n) { symbol = ++label; }
+            buffer[length++] = (char) ('a' + symbol - 1);
+        }
+    }
+    buffer[length++] = '\n';
+
+    return length;
+}
+
+// decodes the adjacency lists of the code with the specified symbols as in
+// Triangulation::build_from_code, where the first occurrence of a vertex
+// assigns the next label, and stores them as rotation system. returns
+// false if the code does not describe a planar triangulation or a
+// triangulated polygon.
+static bool decode_code(const unsigned char *symbols, int length, std::vector<int> &rotation_system) {
+    int n = (int) symbols[0];
+    int m = length - n - 1;
+    if (n < 4 || n > MAX_CODE_ORDER || (m != 6 * n - 12 && m != 4 * n - 6)) { return false; }
+
+    rotation_system.clear();
+    int index = 1;
+    int count = 1;
+    for (int i = 0; i < n; ++i) {
+        while (index < length && symbols[index] != 0) {
+            int j = (int) symbols[index++] - 1;
+            if (j >= n) {
+                if (count >= n) { return false; }
+                j = count++;
+            }
+            rotation_system.push_back(j + 1);
+        }
+        if (index == length) { return false; }
+        rotation_system.push_back(0);
+        index++;
+    }
+    return index == length && is_valid_rotation_system(n, rotation_system);
+}
+
+/* ---------------------------------------------------------------------- *
+ * binary code files
+ * ---------------------------------------------------------------------- */
+
+void write_code_file_header(std::ostream &output_stream, int n, int length, uint64_t count) {
+    char header[CODE_FILE_HEADER_SIZE];
+    memcpy(header, CODE_FILE_MAGIC, 4);
+    store_integer(header + 4, n, 4);
+    store_integer(header + 8, length, 4);
+    store_integer(header + 12, count, 8);
+    output_stream.write(header, CODE_FILE_HEADER_SIZE);
+}
+
+void write_codes_binary(std::ostream &output_stream, const CodeTable &codes) {
+    uint64_t count = codes.size();
+    int n = (count > 0) ? (int) codes[0].symbol(0) : 0;
+    int length = codes.length();
+
+    // the records are written as they are stored in the table
+    write_code_file_header(output_stream, n, length, count);
+    output_stream.write((const char *) codes.data(), (std::streamsize) (count * length));
+}
+
+bool read_codes_binary(std::istream &input_stream, CodeTable &codes) {
+    // read header
+    char header[CODE_FILE_HEADER_SIZE];
+    input_stream.read(header, CODE_FILE_HEADER_SIZE);
+    if (input_stream.gcount() != CODE_FILE_HEADER_SIZE) { return false; }
+    if (memcmp(header, CODE_FILE_MAGIC, 4) != 0) { return false; }
+    int n = (int) load_integer(header + 4, 4);
+    int length = (int) load_integer(header + 8, 4);
+    uint64_t count = load_integer(header + 12, 8);
+
+    if (count == 0) { return true; }
+    if (length <= n) { return false; }
+    if (!codes.empty() && codes.length() != length) { return false; }
+
+    // read records in blocks
+    codes.reserve(codes.size() + count, length);
+    uint64_t records = std::max(1, BLOCK_SIZE / length);
+    std::vector<char> buffer(records * length);
+    std::vector<int> rotation_system;
+    for (uint64_t first = 0; first < count; first += records) {
+        uint64_t block = std::min(records, count - first);
+        input_stream.read(buffer.data(), block * length);
+        if ((uint64_t) input_stream.gcount() != block * length) { return false; }
+        const unsigned char *position = (const unsigned char *) buffer.data();
+        for (uint64_t i = 0; i < block; ++i) {
+            const unsigned char *record = position + i * length;
+            if (record[0] != n || !decode_code(record, length, rotation_system)) { return false; }
+        }
+        codes.append(position, block, length);
+    }
+
+    return true;
+}
+
+/* ---------------------------------------------------------------------- *
+ * text code files
+ * ---------------------------------------------------------------------- */
+
+const char *parse_code(const char *begin, const char *end, std::vector<unsigned char> &symbols) {
+    const char *position = begin;
+
+    // parse n
+    int n = 0;
+    while (position != end && *position >= '0' && *position <= '9') {
+        n = 10 * n + (*position++ - '0');
+        if (n > 127) { return nullptr; }
+    }
+    if (position == begin || n < 3) { return nullptr; }
+
+    // parse adjacency lists and record the degrees of the vertices
+    unsigned char degrees[128];
+    symbols.resize(1);
+    symbols[0] = (unsigned char) n;
+    for (int i = 1; i <= n; ++i) {
+        if (position == end || *position != ' ') { return nullptr; }
+        position++;
+
+        int degree = 0;
+        while (position != end && *position != ' ' && *position != '\n' && *position != '\r') {
+            int label = (unsigned char) *position++ - 'a' + 1;
+            if (label < 1 || label > n) { return nullptr; }
+            symbols.push_back((unsigned char) label);
+            degree++;
+        }
+        if (degree == 0) { return nullptr; }
+        symbols.push_back(0);
+        degrees[i] = (unsigned char) degree;
+    }
+
+    // replace the first occurrence of every vertex by n plus its degree
+    int next = 2;
+    int length = (int) symbols.size();
+    for (int i = 1; i < length; ++i) {
+        int symbol = symbols[i];
+        if (symbol == next) {
+            symbols[i] = (unsigned char) (n + degrees[next++]);
+        } else if (symbol > next) {
+            return nullptr;
+        }
+    }
+
+    return position;
+}
+
+void write_codes_text(std::ostream &output_stream, const CodeTable &codes) {
+    std::vector<char> buffer(BLOCK_SIZE);
+    int size = 0;
+    uint64_t count = codes.size();
+    for (uint64_t i = 0; i < count; ++i) {
+        CodeView code = codes[i];
+        if (size + code.length() + 4 > BLOCK_SIZE) {
+            output_stream.write(buffer.data(), size);
+            size = 0;
+        }
+        size += format_code(code, buffer.data() + size);
+    }
+    output_stream.write(buffer.data(), size);
+}
+
+bool read_codes_text(std::istream &input_stream, std::vector<Code> &codes) {
+    std::vector<char> buffer(BLOCK_SIZE);
+    std::vector<unsigned char> symbols;
+    int size = 0;
+
+    while (input_stream) {
+        // fill buffer
+        input_stream.read(buffer.data() + size, BLOCK_SIZE - size);
+        size += (int) input_stream.gcount();
+        bool last = !input_stream;
+
+        // parse all complete lines
+        const char *position = buffer.data();
+        const char *end = buffer.data() + size;
+        while (position != end) {
+            const char *line_end = (const char *) memchr(position, '\n', end - position);
+            if (line_end == nullptr && !last) { break; }
+            if (*position == '\n') {
+                // skip empty lines
+                position++;
+                continue;
+            }
+            position = parse_code(position, end, symbols);
+            if (position == nullptr) { return false; }
+            codes.push_back(Code(symbols));
+
+            // skip end of line
+            if (position != end && *position == '\r') { position++; }
+            if (position != end && *position != '\n') { return false; }
+            if (position != end) { position++; }
+        }
+
+        // move incomplete line to the front
+        int remaining = (int) (end - position);
+        if (remaining == BLOCK_SIZE) { return false; }
+        memmove(buffer.data(), position, remaining);
+        size = remaining;
+    }
+
+    return size == 0;
+}
+
+/* ---------------------------------------------------------------------- *
+ * canonical codes
+ * ---------------------------------------------------------------------- */
+
+bool canonicalize_code(Code &code) {
+    std::vector<int> rotation_system;
+    if (!decode_code(code.symbols(), code.length(), rotation_system)) { return false; }
+
+    code = Code(Triangulation((int) code.symbol(0), rotation_system));
+    return true;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,85 @@
+/* ---------------------------------------------------------------------- *
+ * codeio.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_CODE_IO__
+#define __FGG_CODE_IO__
+
+#include "triangulation.hpp"
+#include "codetable.hpp"
+
+#include <vector>
+#include <iostream>
+#include <cstdint>
+
+/* ---------------------------------------------------------------------- *
+ * binary code files
+ *
+ * a binary code file starts with a header of 20 bytes: the magic "FGC1",
+ * the number of vertices n and the code length as 32 bit integers, and the
+ * number of codes as 64 bit integer (all little endian). the header is
+ * followed by one record per code, each consisting of the code's symbols.
+ * since all codes of a file have the same length, the records have a
+ * fixed width and the i-th code starts at byte 20 + i * length. the
+ * records are laid out like the codes of a code table.
+ * ---------------------------------------------------------------------- */
+
+// the maximal number of vertices of a triangulation with a code, since
+// the symbols of a code are bytes of at most 2n
+const int MAX_CODE_ORDER = 127;
+
+// the size of the header of a binary code file in bytes
+const int CODE_FILE_HEADER_SIZE = 20;
+
+// writes the header of a binary code file with the specified number of
+// codes of the specified length. the records have to be written afterwards.
+void write_code_file_header(std::ostream &output_stream, int n, int length, uint64_t count);
+
+// writes the specified codes to the stream in the binary format
+void write_codes_binary(std::ostream &output_stream, const CodeTable &codes);
+
+// reads codes in the binary format from the stream and appends them to the
+// specified table. returns false if the stream is not a valid code file,
+// including records that do not describe a triangulation.
+bool read_codes_binary(std::istream &input_stream, CodeTable &codes);
+
+/* ---------------------------------------------------------------------- *
+ * text code files
+ *
+ * a text code file contains one code per line in the format written by
+ * Code::write_to_stream, e.g., "5 bcd aced abed acb bdc".
+ * ---------------------------------------------------------------------- */
+
+// parses the code in text format at the beginning of the characters in
+// [begin, end) and stores its symbols. returns a pointer to the character
+// after the parsed code or nullptr if the text is not a valid code.
+const char *parse_code(const char *begin, const char *end, std::vector<unsigned char> &symbols);
+
+// writes the specified codes to the stream in the text format
+void write_codes_text(std::ostream &output_stream, const CodeTable &codes);
+
+// reads codes in the text format from the stream and appends them to the
+// specified list. returns false if the stream contains an invalid line.
+bool read_codes_text(std::istream &input_stream, std::vector<Code> &codes);
+
+/* ---------------------------------------------------------------------- *
+ * canonical codes
+ *
+ * codes from files are not necessarily canonical: any starting halfedge
+ * yields a code of a triangulation, but only the minimal one identifies
+ * it. codes from outside have to be validated and canonicalized before
+ * they are compared with other codes.
+ * ---------------------------------------------------------------------- */
+
+// replaces the specified code by the canonical code of its triangulation.
+// returns false if the code does not describe a planar triangulation or a
+// triangulated polygon, i.e., if its length is not n + m + 1 for the
+// number m of halfedges of either class or its adjacency lists do not
+// form a valid rotation system.
+bool canonicalize_code(Code &code);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
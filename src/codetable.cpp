@@ -0,0 +1,59 @@
+/* ---------------------------------------------------------------------- *
+ * codetable.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "codetable.hpp"
+
+#include <cassert>
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the code table class
+ * ---------------------------------------------------------------------- */
+
+CodeTable::CodeTable() : size_(0), length_(0) {}
+
+void CodeTable::push_back(const CodeView &code) {
+    append(code.symbols(), 1, code.length());
+}
+
+void CodeTable::append(const unsigned char *records, uint64_t count, int length) {
+    assert(size_ == 0 || length == length_);
+    length_ = length;
+    symbols_.insert(symbols_.end(), records, records + count * length);
+    size_ += count;
+}
+
+void CodeTable::reserve(uint64_t count, int length) {
+    assert(size_ == 0 || length == length_);
+    symbols_.reserve(count * length);
+}
+
+uint64_t CodeTable::size() const {
+    return size_;
+}
+
+int CodeTable::length() const {
+    return length_;
+}
+
+bool CodeTable::empty() const {
+    return size_ == 0;
+}
+
+const unsigned char *CodeTable::data() const {
+    return symbols_.data();
+}
+
+long CodeTable::bytes() const {
+    return (long) symbols_.capacity();
+}
+
+void CodeTable::clear() {
+    std::vector<unsigned char>().swap(symbols_);
+    size_ = 0;
+    length_ = 0;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
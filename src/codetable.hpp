@@ -0,0 +1,79 @@
+/* ---------------------------------------------------------------------- *
+ * codetable.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_CODE_TABLE__
+#define __FGG_CODE_TABLE__
+
+#include "triangulation.hpp"
+
+#include <vector>
+#include <cstdint>
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the code table class
+ *
+ * a code table stores codes of the same length one after another in a
+ * single buffer, i.e., the i-th code starts at byte i * length. this is
+ * exactly the layout of the records of a binary code file, hence a table
+ * is written and read as one block. the codes are accessed by views into
+ * the buffer, which are invalidated when codes are added.
+ * ---------------------------------------------------------------------- */
+
+class CodeTable {
+public:
+    // constructor that creates an empty table
+    CodeTable();
+
+private:
+    // the symbols of all codes
+    std::vector<unsigned char> symbols_;
+
+    // the number of codes
+    uint64_t size_;
+
+    // the length of the codes (0 if the table is empty)
+    int length_;
+
+public:
+    // appends the specified code, which must have the length of the codes
+    // in the table
+    void push_back(const CodeView &code);
+
+    // appends the specified number of codes of the specified length from
+    // the array of records
+    void append(const unsigned char *records, uint64_t count, int length);
+
+    // reserves memory for the specified number of codes of the specified
+    // length
+    void reserve(uint64_t count, int length);
+
+    // returns a view of the i-th code
+    CodeView operator[](uint64_t i) const {
+        return CodeView(symbols_.data() + i * length_, length_);
+    }
+
+    // returns the number of codes
+    uint64_t size() const;
+
+    // returns the length of the codes
+    int length() const;
+
+    // returns whether the table is empty
+    bool empty() const;
+
+    // returns the records of all codes
+    const unsigned char *data() const;
+
+    // returns the number of bytes allocated by the table
+    long bytes() const;
+
+    // removes all codes and frees the memory of the table
+    void clear();
+};
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,183 @@
+/* ---------------------------------------------------------------------- *
+ * distancematrix.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "distancematrix.hpp"
+
+#include <thread>
+#include <algorithm>
+#include <utility>
+#include <cassert>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/* ---------------------------------------------------------------------- *
+ * constants
+ * ---------------------------------------------------------------------- */
+
+// the number of sources of a bit-parallel breadth first search
+const int BLOCK_SOURCES = 64;
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the distance matrix class
+ * ---------------------------------------------------------------------- */
+
+DistanceMatrix::DistanceMatrix() : size_(0), mapping_(nullptr), data_(nullptr) {
+}
+
+DistanceMatrix::~DistanceMatrix() {
+    close();
+}
+
+void DistanceMatrix::close() {
+    if (mapping_ != nullptr) {
+        munmap(mapping_, bytes());
+        mapping_ = nullptr;
+    }
+}
+
+bool DistanceMatrix::compute(const Graph &graph, int threads, const char *path) {
+    close();
+    buffer_.clear();
+    data_ = nullptr;
+
+    // compute row offsets
+    size_ = (int) graph.size();
+    offsets_.resize(size_ + 1);
+    offsets_[0] = 0;
+    for (int i = 0; i < size_; ++i) {
+        uint64_t length = (uint64_t) (size_ - i - 1);
+        offsets_[i + 1] = offsets_[i] + (length + 1) / 2;
+    }
+
+    // allocate memory or map file
+    std::size_t length = bytes();
+    if (path != nullptr) {
+        int file = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (file < 0) { return false; }
+        if (ftruncate(file, (off_t) length) != 0) {
+            ::close(file);
+            return false;
+        }
+        if (length > 0) {
+            mapping_ = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+        }
+        ::close(file);
+        if (mapping_ == MAP_FAILED) {
+            mapping_ = nullptr;
+            return false;
+        }
+        data_ = (unsigned char *) mapping_;
+    } else {
+        buffer_.assign(length, 0);
+        data_ = buffer_.data();
+    }
+
+    // fill blocks of sources
+    int blocks = (size_ + BLOCK_SOURCES - 1) / BLOCK_SOURCES;
+    threads = std::max(1, std::min(threads, blocks));
+    std::vector<char> results(threads, 1);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; ++i) {
+        workers.push_back(std::thread(fill_blocks, this, &graph, i, threads, &results[i]));
+    }
+    for (std::thread &worker : workers) { worker.join(); }
+
+    for (char result : results) {
+        if (!result) { return false; }
+    }
+    return true;
+}
+
+void DistanceMatrix::fill_blocks(DistanceMatrix *matrix, const Graph *graph, int first, int threads,
+                                 char *result) {
+    for (int begin = first * BLOCK_SOURCES; begin < matrix->size_; begin += threads * BLOCK_SOURCES) {
+        int end = std::min(matrix->size_, begin + BLOCK_SOURCES);
+        if (!matrix->fill(*graph, begin, end)) { *result = 0; }
+    }
+}
+
+bool DistanceMatrix::fill(const Graph &graph, int begin, int end) {
+    // the sources that have reached each vertex so far and in the last layer
+    std::vector<uint64_t> visited(size_, 0);
+    std::vector<uint64_t> frontier(size_, 0);
+    std::vector<uint64_t> next(size_, 0);
+    for (int source = begin; source < end; ++source) {
+        uint64_t bit = (uint64_t) 1 << (source - begin);
+        visited[source] = bit;
+        frontier[source] = bit;
+    }
+
+    bool valid = true;
+    bool active = true;
+    for (int distance = 1; active; ++distance) {
+        active = false;
+        for (int vertex = 0; vertex < size_; ++vertex) {
+            uint64_t mask = 0;
+            for (int neighbor : graph[vertex]) { mask |= frontier[neighbor]; }
+            mask &= ~visited[vertex];
+            next[vertex] = mask;
+            if (mask == 0) { continue; }
+
+            active = true;
+            visited[vertex] |= mask;
+            if (distance > MAX_DISTANCE) {
+                valid = false;
+                continue;
+            }
+
+            // store distances of sources with smaller index
+            while (mask != 0) {
+                int source = begin + __builtin_ctzll(mask);
+                mask &= mask - 1;
+                if (source >= vertex) { continue; }
+                uint64_t index = (uint64_t) (vertex - source - 1);
+                unsigned char &byte = data_[offsets_[source] + index / 2];
+                byte |= (unsigned char) ((index % 2 == 0) ? distance : distance << 4);
+            }
+        }
+        frontier.swap(next);
+    }
+
+    // check whether all sources reached all vertices
+    uint64_t all = (end - begin == 64) ? ~(uint64_t) 0 : (((uint64_t) 1 << (end - begin)) - 1);
+    for (int vertex = 0; vertex < size_; ++vertex) {
+        if (visited[vertex] != all) { valid = false; }
+    }
+    return valid;
+}
+
+int DistanceMatrix::size() const {
+    return size_;
+}
+
+std::size_t DistanceMatrix::bytes() const {
+    return offsets_.empty() ? 0 : (std::size_t) offsets_.back();
+}
+
+int DistanceMatrix::get(int vertex_a, int vertex_b) const {
+    assert(vertex_a >= 0 && vertex_a < size_ && vertex_b >= 0 && vertex_b < size_);
+    if (vertex_a == vertex_b) { return 0; }
+    if (vertex_a > vertex_b) { std::swap(vertex_a, vertex_b); }
+    uint64_t index = (uint64_t) (vertex_b - vertex_a - 1);
+    unsigned char byte = data_[offsets_[vertex_a] + index / 2];
+    return (index % 2 == 0) ? (byte & 0x0f) : (byte >> 4);
+}
+
+void DistanceMatrix::row(int vertex, std::vector<unsigned char> &distances) const {
+    distances.resize(size_);
+    for (int i = 0; i < vertex; ++i) { distances[i] = (unsigned char) get(i, vertex); }
+    distances[vertex] = 0;
+
+    // the distances to larger vertices are contiguous
+    const unsigned char *position = data_ + offsets_[vertex];
+    for (int i = vertex + 1; i < size_; i += 2, ++position) {
+        distances[i] = *position & 0x0f;
+        if (i + 1 < size_) { distances[i + 1] = *position >> 4; }
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,94 @@
+/* ---------------------------------------------------------------------- *
+ * distancematrix.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_DISTANCE_MATRIX__
+#define __FGG_DISTANCE_MATRIX__
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+typedef std::vector<std::vector<int> > Graph;
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the distance matrix class
+ *
+ * the distance matrix stores the distances between all pairs of vertices
+ * of a graph with 4 bits per distance. since distances are symmetric only
+ * the pairs (i, j) with i < j are stored: row i holds the distances from i
+ * to i + 1, ..., size - 1 and starts at a byte boundary, so rows can be
+ * filled independently and scanned contiguously. the matrix is kept in
+ * memory or in a memory mapped file.
+ *
+ * the matrix is filled by a bit-parallel breadth first search that
+ * advances 64 sources at once: every vertex holds a bit mask of the
+ * sources that have reached it, and a layer is computed by or-ing the
+ * masks of the neighbors.
+ * ---------------------------------------------------------------------- */
+
+class DistanceMatrix {
+public:
+    // the largest distance that can be stored
+    static const int MAX_DISTANCE = 15;
+
+    // constructor that creates an empty matrix
+    DistanceMatrix();
+
+    // destructor
+    ~DistanceMatrix();
+
+private:
+    // the number of vertices
+    int size_;
+
+    // the byte offset of every row (size + 1 entries)
+    std::vector<uint64_t> offsets_;
+
+    // the packed distances if the matrix is kept in memory
+    std::vector<unsigned char> buffer_;
+
+    // the memory mapped file if the matrix is spilled to a file
+    void *mapping_;
+
+    // the packed distances
+    unsigned char *data_;
+
+    // unmaps the file if a file is mapped
+    void close();
+
+    // computes the distances of the sources in [begin, end) to all vertices
+    // with larger index. returns false if a distance is too large or if a
+    // vertex cannot be reached.
+    bool fill(const Graph &graph, int begin, int end);
+
+    // fills the rows of every threads-th block of 64 sources starting at
+    // the specified block and stores whether all blocks are valid
+    static void fill_blocks(DistanceMatrix *matrix, const Graph *graph, int first, int threads, char *result);
+
+public:
+    // computes the distances between all pairs of vertices of the specified
+    // graph using the specified number of threads. if path is not null, the
+    // matrix is stored in a memory mapped file at this path. returns false
+    // if the file cannot be created or if the graph has a larger diameter
+    // than MAX_DISTANCE or is not connected.
+    bool compute(const Graph &graph, int threads = 1, const char *path = nullptr);
+
+    // returns the number of vertices
+    int size() const;
+
+    // returns the number of bytes of the packed distances
+    std::size_t bytes() const;
+
+    // returns the distance between the two specified vertices
+    int get(int vertex_a, int vertex_b) const;
+
+    // stores the distances from the specified vertex to all vertices
+    void row(int vertex, std::vector<unsigned char> &distances) const;
+};
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,109 @@
+/* ---------------------------------------------------------------------- *
+ * estimate.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "estimate.hpp"
+#include "search.hpp"
+
+#include <cmath>
+#include <thread>
+#include <utility>
+#include <algorithm>
+
+/* ---------------------------------------------------------------------- *
+ * helper functions
+ * ---------------------------------------------------------------------- */
+
+// a sample consists of the layer of a triangulation and its weight
+// a / 2m, where a is the number of its automorphisms
+typedef std::pair<int, double> Sample;
+
+// runs every threads-th walker starting with the specified one and
+// collects the samples
+static void run_walkers(const SamplerSettings *settings, int first, std::vector<Sample> *samples) {
+    Code canonical_code(Triangulation(settings->n));
+    std::vector<Code> path;
+    for (int i = first; i < settings->walkers; i += settings->threads) {
+        FlipWalker walker(settings->n, settings->seed + i, false);
+        walker.walk(settings->burn_in);
+        for (long j = 0; j < settings->samples; ++j) {
+            if (j > 0) { walker.walk(settings->spacing); }
+            const Triangulation &triangulation = walker.triangulation();
+            int layer = flip_distance(canonical_code, Code(triangulation), path);
+            double weight = Code::automorphisms(triangulation) / (double) triangulation.size();
+            samples->push_back(std::make_pair(layer, weight / 2));
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * estimation of the flip graph size
+ * ---------------------------------------------------------------------- */
+
+double rooted_triangulations(int n) {
+    // 2 (4k + 1)! / ((k + 1)! (3k + 2)!) with k = n - 3 inner vertices
+    int k = n - 3;
+    double logarithm = std::log(2.0) + std::lgamma(4.0 * k + 2) - std::lgamma(k + 2.0) - std::lgamma(3.0 * k + 3);
+    return std::exp(logarithm);
+}
+
+void estimate_flip_graph(const SamplerSettings &settings, FlipGraphEstimate &estimate) {
+    // collect samples
+    int threads = std::max(1, std::min(settings.threads, settings.walkers));
+    SamplerSettings thread_settings = settings;
+    thread_settings.threads = threads;
+    std::vector<std::vector<Sample> > thread_samples(threads);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; ++i) {
+        workers.push_back(std::thread(run_walkers, &thread_settings, i, &thread_samples[i]));
+    }
+    for (std::thread &worker : workers) { worker.join(); }
+
+    std::vector<Sample> samples;
+    for (const std::vector<Sample> &list : thread_samples) {
+        samples.insert(samples.end(), list.begin(), list.end());
+    }
+    long count = (long) samples.size();
+    estimate.samples = count;
+    estimate.layers.clear();
+    estimate.layer_errors.clear();
+    estimate.size = 0;
+    estimate.size_error = 0;
+    if (count == 0) { return; }
+
+    // the estimate of a layer is the mean of the weights of its samples
+    // (and zero for all other samples) times the number of rooted
+    // triangulations. the confidence intervals use the normal approximation.
+    int layers = 0;
+    for (const Sample &sample : samples) { layers = std::max(layers, sample.first + 1); }
+    std::vector<double> sums(layers, 0);
+    std::vector<double> squares(layers, 0);
+    double sum = 0;
+    double square = 0;
+    for (const Sample &sample : samples) {
+        sums[sample.first] += sample.second;
+        squares[sample.first] += sample.second * sample.second;
+        sum += sample.second;
+        square += sample.second * sample.second;
+    }
+
+    double rooted = rooted_triangulations(settings.n);
+    estimate.layers.resize(layers);
+    estimate.layer_errors.resize(layers);
+    for (int i = 0; i <= layers; ++i) {
+        double mean = ((i < layers) ? sums[i] : sum) / count;
+        double variance = ((i < layers) ? squares[i] : square) / count - mean * mean;
+        double error = 1.96 * std::sqrt(std::max(0.0, variance) / count);
+        if (i < layers) {
+            estimate.layers[i] = rooted * mean;
+            estimate.layer_errors[i] = rooted * error;
+        } else {
+            estimate.size = rooted * mean;
+            estimate.size_error = rooted * error;
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
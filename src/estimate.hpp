@@ -0,0 +1,55 @@
+/* ---------------------------------------------------------------------- *
+ * estimate.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_ESTIMATE__
+#define __FGG_ESTIMATE__
+
+#include "sampler.hpp"
+
+#include <vector>
+
+/* ---------------------------------------------------------------------- *
+ * estimation of the flip graph size
+ *
+ * the number of rooted triangulations on n vertices is known exactly
+ * (tutte), and a triangulation with a automorphisms (including orientation
+ * reversing ones) has 2m / a rootings. hence the number of triangulations
+ * is the number of rooted triangulations times the expected value of
+ * a / 2m for a uniformly random rooted triangulation. random walks of flip
+ * walkers sample labeled triangulations uniformly and therefore rooted
+ * triangulations as well. the layer of a sample is its flip distance to the
+ * canonical triangulation, which is computed by a bidirectional search.
+ * ---------------------------------------------------------------------- */
+
+struct FlipGraphEstimate {
+    // the estimated number of triangulations at each distance from the
+    // canonical triangulation
+    std::vector<double> layers;
+
+    // the half widths of the 95% confidence intervals of the layer sizes
+    std::vector<double> layer_errors;
+
+    // the estimated number of triangulations
+    double size;
+
+    // the half width of the 95% confidence interval of the size
+    double size_error;
+
+    // the number of samples
+    long samples;
+};
+
+// returns the number of rooted triangulations on n vertices
+double rooted_triangulations(int n);
+
+// estimates the size and the layer sizes of the flip graph on settings.n
+// vertices from the samples of the specified walkers. the samples are
+// treated as independent, so the spacing should be large enough.
+void estimate_flip_graph(const SamplerSettings &settings, FlipGraphEstimate &estimate);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
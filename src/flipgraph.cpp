@@ -4,33 +4,231 @@
 
 #include "flipgraph.hpp"
 #include "triangulation.hpp"
+#include "codeio.hpp"
+#include "codeindex.hpp"
+#include "flipview.hpp"
+#include "profile.hpp"
+#include "progress.hpp"
+#include "polygon.hpp"
 
 #include <queue>
+#include <deque>
 #include <map>
+#include <unordered_map>
 #include <set>
 #include <utility>
 #include <iostream>
 #include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cassert>
 
 typedef FlipGraph::Graph Graph;
 
-void FlipGraph::compute(int n) {
+// the magic bytes at the start of a binary flip graph
+const char FLIP_GRAPH_MAGIC[4] = {'F', 'G', 'G', '1'};
+
+// the number of triangulations cached by code(i) if codes are not stored
+const std::size_t TRIANGULATION_CACHE_SIZE = 64;
+
+typedef std::unordered_map<Code, int, CodeHash> CodeMap;
+
+// the queue of the exploration, whose allocations are accounted
+typedef std::pair<Triangulation *, int> QueueEntry;
+typedef std::deque<QueueEntry, CountingAllocator<QueueEntry> > TriangulationQueue;
+
+/* ---------------------------------------------------------------------- *
+ * code offset table
+ *
+ * the map from codes to indices of the exploration. it is an open
+ * addressing hash set with linear probing of indices into the code table,
+ * which holds the codes themselves. thus, every code is stored only once
+ * and an entry takes four bytes. the table is at most half full.
+ * ---------------------------------------------------------------------- */
+
+class CodeOffsetTable {
+public:
+    CodeOffsetTable(const CodeTable &codes) : codes_(codes), slots_(1024, -1), size_(0), slot_(0) {}
+
+    // returns the index of the specified code or -1 if it is not contained.
+    // in the latter case, the slot of the code is kept for insert().
+    int find(const Code &code) {
+        uint64_t mask = slots_.size() - 1;
+        CodeView view(code);
+        for (slot_ = hash_symbols(code.symbols(), code.length(), 0) & mask;; slot_ = (slot_ + 1) & mask) {
+            int index = slots_[slot_];
+            if (index < 0 || codes_[index] == view) { return index; }
+        }
+    }
+
+    // inserts the index of the code that find() did not find last, which
+    // must have been appended to the code table since
+    void insert(int index) {
+        slots_[slot_] = index;
+        size_++;
+        if (2 * size_ > slots_.size()) { grow(); }
+    }
+
+    // returns the number of bytes of the table
+    long bytes() const { return (long) (slots_.capacity() * sizeof(int)); }
+
+private:
+    const CodeTable &codes_;
+    std::vector<int> slots_;
+    uint64_t size_;
+    uint64_t slot_;
+
+    void grow() {
+        std::vector<int> slots(2 * slots_.size(), -1);
+        uint64_t mask = slots.size() - 1;
+        for (int index : slots_) {
+            if (index < 0) { continue; }
+            CodeView code = codes_[index];
+            uint64_t slot = hash_symbols(code.symbols(), code.length(), 0) & mask;
+            while (slots[slot] >= 0) { slot = (slot + 1) & mask; }
+            slots[slot] = index;
+        }
+        slots_.swap(slots);
+    }
+};
+
+// a queued triangulated polygon together with the polygon edge of every
+// halfedge of the triangulation that rebuild() obtains by replaying the
+// flips of the search tree, such that flips can be recorded as halfedges
+struct PolygonEntry {
+    Polygon polygon;
+    int index;
+    unsigned short edges[4 * MAX_POLYGON_ORDER - 6];
+};
+
+// the queue and the map from keys to indices of the polygon exploration,
+// whose allocations are accounted
+typedef std::deque<PolygonEntry, CountingAllocator<PolygonEntry> > PolygonQueue;
+typedef std::unordered_map<PolygonKey, int, PolygonKeyHash, std::equal_to<PolygonKey>,
+                           CountingAllocator<std::pair<const PolygonKey, int> > > PolygonIndexMap;
+
+// returns the polygon edge between the vertices a and c
+static unsigned short polygon_edge(int a, int c) {
+    return (unsigned short) (std::min(a, c) * MAX_POLYGON_ORDER + std::max(a, c));
+}
+
+// maps the vertices of the triangulation onto those of the other one by
+// following the next and twin pointers from the specified halfedges in
+// both. the vertices are identified by their labels. returns false if the
+// halfedges do not correspond under an isomorphism.
+static bool match_vertices(Halfedge *halfedge, Halfedge *other_halfedge, int n, std::vector<int> &images) {
+    std::map<Halfedge *, Halfedge *> matched;
+    std::vector<std::pair<Halfedge *, Halfedge *> > stack(1, std::make_pair(halfedge, other_halfedge));
+    images.assign(n, -1);
+    while (!stack.empty()) {
+        Halfedge *current = stack.back().first;
+        Halfedge *image = stack.back().second;
+        stack.pop_back();
+
+        std::pair<std::map<Halfedge *, Halfedge *>::iterator, bool> result
+                = matched.insert(std::make_pair(current, image));
+        if (!result.second) {
+            if (result.first->second != image) { return false; }
+            continue;
+        }
+        int &vertex_image = images[current->target()->label()];
+        if (vertex_image >= 0 && vertex_image != image->target()->label()) { return false; }
+        vertex_image = image->target()->label();
+        stack.push_back(std::make_pair(current->next(), image->next()));
+        stack.push_back(std::make_pair(current->twin(), image->twin()));
+    }
+    return true;
+}
+
+// computes the polygon edges of the halfedges of the canonical outerplanar
+// triangulation, whose vertices are matched with those of the canonical
+// polygon, since both are the canonical triangulation of the class
+static void polygon_edges(int n, unsigned short *edges) {
+    Triangulation triangulation(n, TRIANGULATION_OUTERPLANAR);
+    std::vector<int> rotation_system;
+    Polygon(n).rotation_system(rotation_system);
+    Triangulation fan(n, rotation_system);
+
+    // the labels of the vertices are their indices, which are the polygon
+    // vertices in the fan
+    for (int i = 0; i < n; ++i) {
+        triangulation.vertex(i)->set_label(i);
+        fan.vertex(i)->set_label(i);
+    }
+    int m = triangulation.size();
+    std::vector<int> polygon_vertices;
+    bool matched = false;
+    for (int i = 0; i < m && !matched; ++i) {
+        matched = match_vertices(triangulation.halfedge(0), fan.halfedge(i), n, polygon_vertices);
+    }
+    assert(matched);
+
+    for (int i = 0; i < m; ++i) {
+        Halfedge *halfedge = triangulation.halfedge(i);
+        edges[i] = polygon_edge(polygon_vertices[halfedge->twin()->target()->label()],
+                                polygon_vertices[halfedge->target()->label()]);
+    }
+}
+
+FlipGraph::FlipGraph() : n_(0), class_(CLASS_PLANAR), memory_limit_(0) {
+    memory_ = MemoryUsage{0, 0, 0, 0, 0};
+}
+
+bool FlipGraph::compute(int n, bool store_codes, Profile *profile, Progress *progress) {
     graph_.clear();
+    codes_.clear();
+    parents_.clear();
+    flips_.clear();
+    automorphisms_.clear();
+    cache_.clear();
+    cache_positions_.clear();
+    n_ = n;
     int count = 0;
 
-    std::queue<std::pair<Triangulation *, int> > queue;
-    std::map<Code, int> indices;
+    // the bytes allocated by the queue are counted by its allocator, the
+    // other structures are accounted after every expansion. the codes are
+    // stored in any case, since the map from codes to indices refers to
+    // them, and dropped at the end unless store_codes is true.
+    long queue_bytes = 0;
+    long adjacency_bytes = 0;
+    long queued_triangulations = 0;
+    bool rebuild_queued = false;
+    TriangulationQueue queue{CountingAllocator<QueueEntry>(&queue_bytes)};
+    CodeOffsetTable indices(codes_);
+    memory_ = MemoryUsage{0, 0, 0, 0, 0};
+    MemoryUsage usage = memory_;
+
+    // time spent on the single operations if a profile is recorded. the
+    // layers end when the index reaches the number of triangulations that
+    // were known when the layer started.
+    double flip_seconds = 0;
+    double code_seconds = 0;
+    double lookup_seconds = 0;
+    long flip_count = 0;
+    long edge_count = 0;
+    int layer = 0;
+    int layer_end = 1;
+    int layer_phase = (profile) ? profile->phase("layer 0") : -1;
+    if (profile) { profile->begin(layer_phase); }
+    std::chrono::steady_clock::time_point start_time;
 
     // build canonical triangulation on n vertices
-    Triangulation *triangulation = new Triangulation(n);
-    Code *code = new Code(*triangulation);
+    Triangulation *triangulation = new Triangulation(n, canonical_type(class_));
+    int automorphisms;
+    Code *code = new Code(*triangulation, automorphisms);
 
     // add canonical triangulation
     int index = count++;
-    indices[*code] = 0;
-    graph_.push_back(std::vector<int>());
+    indices.find(*code);
     codes_.push_back(*code);
-    queue.push(std::make_pair(triangulation, index));
+    indices.insert(0);
+    graph_.push_back(std::vector<int>());
+    parents_.push_back(-1);
+    flips_.push_back(0);
+    automorphisms_.push_back((unsigned short) automorphisms);
+    queue.push_back(std::make_pair(triangulation, index));
+    queued_triangulations++;
+    long bytes_per_triangulation = triangulation_bytes(*triangulation);
 
     delete code;
 
@@ -39,7 +237,30 @@ void FlipGraph::compute(int n) {
         // get current triangulation
         triangulation = queue.front().first;
         index = queue.front().second;
-        queue.pop();
+        queue.pop_front();
+        if (triangulation == nullptr) {
+            // replay the flips from the closest cached ancestor
+            triangulation = new Triangulation(rebuild(index));
+        } else {
+            queued_triangulations--;
+        }
+
+        if (index == layer_end) {
+            layer++;
+            layer_end = count;
+            if (profile) {
+                profile->end(layer_phase);
+                layer_phase = profile->phase("layer " + std::to_string(layer));
+                profile->begin(layer_phase);
+            }
+        }
+
+        if (progress && progress->due()) {
+            // every edge is found from both of its triangulations
+            ProgressState state = {layer, (long) queue.size(), count, edge_count / 2, flip_count, flip_count / 2,
+                                   usage.total()};
+            progress->report(state);
+        }
 
         // loop through neighboring triangulations
         int m = triangulation->size();
@@ -47,48 +268,418 @@ void FlipGraph::compute(int n) {
         for (int i = 0; i < m; ++i) {
             Halfedge *halfedge = triangulation->halfedge(i);
             if (triangulation->is_representative(halfedge) && triangulation->is_flippable(halfedge)) {
+                if (profile) { start_time = std::chrono::steady_clock::now(); }
                 triangulation->flip(halfedge);
+                if (profile) { flip_seconds += seconds_since(start_time); }
 
-                Code triangulation_code(*triangulation);
-                int other_index = 0;
-                if (indices.count(triangulation_code) == 0) {
+                if (profile) { start_time = std::chrono::steady_clock::now(); }
+                Code triangulation_code(*triangulation, automorphisms);
+                if (profile) { code_seconds += seconds_since(start_time); }
+
+                if (profile) { start_time = std::chrono::steady_clock::now(); }
+                int other_index = indices.find(triangulation_code);
+                if (other_index < 0) {
                     // add newly discovered triangulation
                     other_index = count++;
-                    indices[triangulation_code] = other_index;
-                    graph_.push_back(std::vector<int>());
                     codes_.push_back(triangulation_code);
-                    queue.push(std::make_pair(new Triangulation(*triangulation), other_index));
-                } else {
-                    // get index of triangulation
-                    other_index = indices[triangulation_code];
+                    indices.insert(other_index);
+                    graph_.push_back(std::vector<int>());
+                    parents_.push_back(index);
+                    flips_.push_back((unsigned short) i);
+                    automorphisms_.push_back((unsigned short) automorphisms);
+                    if (rebuild_queued) {
+                        queue.push_back(std::make_pair(nullptr, other_index));
+                    } else {
+                        queue.push_back(std::make_pair(new Triangulation(*triangulation), other_index));
+                        queued_triangulations++;
+                    }
                 }
+                if (profile) { lookup_seconds += seconds_since(start_time); }
 
                 // add edge if not already present
                 if (std::count(graph_[index].begin(), graph_[index].end(), other_index) == 0
                     && index != other_index) {
+                    std::size_t capacity = graph_[index].capacity();
                     graph_[index].push_back(other_index);
+                    adjacency_bytes += (long) ((graph_[index].capacity() - capacity) * sizeof(int));
+                    edge_count++;
                 }
 
                 // note: after two flips the halfedge and its twin are swapped
                 // all other edges stay in place. this is crucial since
                 // we loop over all edges.
+                if (profile) { start_time = std::chrono::steady_clock::now(); }
                 triangulation->flip(halfedge);
-
+                if (profile) { flip_seconds += seconds_since(start_time); }
+                flip_count += 2;
             }
         }
 
         delete triangulation;
+
+        // account memory and degrade if the limit is near
+        usage.graph = (long) (graph_.capacity() * sizeof(std::vector<int>)) + adjacency_bytes;
+        usage.codes = codes_.bytes();
+        usage.parents = (long) (parents_.capacity() * sizeof(int)
+                                + (flips_.capacity() + automorphisms_.capacity()) * sizeof(unsigned short));
+        usage.indices = indices.bytes();
+        usage.queue = queue_bytes + queued_triangulations * bytes_per_triangulation;
+        if (usage.total() > memory_.total()) { memory_ = usage; }
+
+        if (memory_limit_ > 0 && usage.total() > MEMORY_DEGRADE_FRACTION * memory_limit_) {
+            if (!rebuild_queued) {
+                // queued triangulations are rebuilt when they are expanded
+                for (QueueEntry &entry : queue) {
+                    delete entry.first;
+                    entry.first = nullptr;
+                }
+                queued_triangulations = 0;
+                rebuild_queued = true;
+            } else if (usage.total() > memory_limit_) {
+                for (QueueEntry &entry : queue) { delete entry.first; }
+                if (profile) { profile->end(layer_phase); }
+                return false;
+            }
+        }
     }
 
+    if (profile) {
+        profile->end(layer_phase);
+        profile->add(profile->phase("flipping"), flip_seconds, flip_count);
+        profile->add(profile->phase("coding"), code_seconds, flip_count / 2);
+        profile->add(profile->phase("lookup"), lookup_seconds, flip_count / 2);
+    }
 
+    // codes are rebuilt from the search tree on demand
+    if (!store_codes) { codes_.clear(); }
+    return true;
+}
+
+bool FlipGraph::compute_polygons(int n, bool store_codes, Profile *profile, Progress *progress) {
+    assert(n >= 4 && n <= MAX_POLYGON_ORDER);
+    graph_.clear();
+    codes_.clear();
+    parents_.clear();
+    flips_.clear();
+    automorphisms_.clear();
+    cache_.clear();
+    cache_positions_.clear();
+    memory_ = MemoryUsage{0, 0, 0, 0, 0};
+    n_ = n;
+    class_ = CLASS_OUTERPLANAR;
+
+    // the bytes allocated by the queue and the map are counted by their
+    // allocators, the other structures are accounted after every expansion
+    long queue_bytes = 0;
+    long index_bytes = 0;
+    long adjacency_bytes = 0;
+    PolygonQueue queue{CountingAllocator<PolygonEntry>(&queue_bytes)};
+    PolygonIndexMap indices{0, PolygonKeyHash(), std::equal_to<PolygonKey>(),
+                            CountingAllocator<std::pair<const PolygonKey, int> >(&index_bytes)};
+    MemoryUsage usage = memory_;
+
+    std::vector<int> rotation_system;
+    long flip_count = 0;
+    long edge_count = 0;
+    int layer = 0;
+    int layer_end = 1;
+    int layer_phase = (profile) ? profile->phase("layer 0") : -1;
+    if (profile) { profile->begin(layer_phase); }
+
+    // add canonical triangulation
+    PolygonEntry entry = {Polygon(n), 0, {}};
+    polygon_edges(n, entry.edges);
+    int m = 4 * n - 6;
+
+    // flips keep the halfedges paired with their twins, so the
+    // representative halfedges are those with a smaller index than their
+    // twin throughout
+    std::vector<bool> representative(m, false);
+    for (int i = 0; i < m; ++i) {
+        representative[i] = std::find(entry.edges + i + 1, entry.edges + m, entry.edges[i]) != entry.edges + m;
+    }
+    indices[entry.polygon.key()] = 0;
+    graph_.push_back(std::vector<int>());
+    parents_.push_back(-1);
+    flips_.push_back(0);
+    automorphisms_.push_back((unsigned short) entry.polygon.automorphisms());
+    queue.push_back(entry);
+    int count = 1;
+
+    // explore flip graph using a bfs
+    while (!queue.empty()) {
+        // appending to the queue keeps the references to its entries valid
+        PolygonEntry &front = queue.front();
+        Polygon &polygon = front.polygon;
+        int index = front.index;
+
+        if (index == layer_end) {
+            layer++;
+            layer_end = count;
+            if (profile) {
+                profile->end(layer_phase);
+                layer_phase = profile->phase("layer " + std::to_string(layer));
+                profile->begin(layer_phase);
+            }
+        }
+
+        if (progress && progress->due()) {
+            ProgressState state = {layer, (long) queue.size(), count, edge_count / 2, flip_count, flip_count / 2,
+                                   usage.total()};
+            progress->report(state);
+        }
+
+        // the codes are computed in the order of the indices
+        if (store_codes) {
+            polygon.rotation_system(rotation_system);
+            codes_.push_back(Code(Triangulation(n, rotation_system)));
+        }
+
+        // loop through neighboring triangulations in the order of the
+        // halfedges, which discovers them in the same order as compute(n)
+        for (int i = 0; i < m; ++i) {
+            int a = front.edges[i] / MAX_POLYGON_ORDER;
+            int c = front.edges[i] % MAX_POLYGON_ORDER;
+            if (!representative[i] || !polygon.is_diagonal(a, c)) { continue; }
+            std::pair<int, int> flipped = polygon.flip(a, c);
+            PolygonKey key = polygon.key();
+
+            int other_index;
+            PolygonIndexMap::iterator it = indices.find(key);
+            if (it == indices.end()) {
+                // add newly discovered triangulation. the flipped diagonal
+                // is recorded by its representative halfedge, which holds
+                // the new diagonal afterwards as well as its twin.
+                other_index = count++;
+                indices[key] = other_index;
+                graph_.push_back(std::vector<int>());
+                automorphisms_.push_back((unsigned short) polygon.automorphisms());
+                PolygonEntry other = {polygon, other_index, {}};
+                for (int j = 0; j < m; ++j) {
+                    if (front.edges[j] == front.edges[i]) {
+                        other.edges[j] = polygon_edge(flipped.first, flipped.second);
+                    } else {
+                        other.edges[j] = front.edges[j];
+                    }
+                }
+                parents_.push_back(index);
+                flips_.push_back((unsigned short) i);
+                queue.push_back(other);
+            } else {
+                other_index = it->second;
+            }
+
+            // add edge if not already present
+            if (std::count(graph_[index].begin(), graph_[index].end(), other_index) == 0
+                && index != other_index) {
+                std::size_t capacity = graph_[index].capacity();
+                graph_[index].push_back(other_index);
+                adjacency_bytes += (long) ((graph_[index].capacity() - capacity) * sizeof(int));
+                edge_count++;
+            }
+
+            polygon.flip(flipped.first, flipped.second);
+            flip_count += 2;
+        }
+        queue.pop_front();
+
+        // account memory and drop the codes if the limit is near
+        usage.graph = (long) (graph_.capacity() * sizeof(std::vector<int>)) + adjacency_bytes;
+        usage.codes = codes_.bytes();
+        usage.parents = (long) (parents_.capacity() * sizeof(int)
+                                + (flips_.capacity() + automorphisms_.capacity()) * sizeof(unsigned short));
+        usage.indices = index_bytes;
+        usage.queue = queue_bytes;
+        if (usage.total() > memory_.total()) { memory_ = usage; }
+
+        if (memory_limit_ > 0 && usage.total() > MEMORY_DEGRADE_FRACTION * memory_limit_) {
+            if (store_codes) {
+                // codes are rebuilt from the search tree on demand
+                codes_.clear();
+                store_codes = false;
+            } else if (usage.total() > memory_limit_) {
+                if (profile) { profile->end(layer_phase); }
+                return false;
+            }
+        }
+    }
+
+    if (profile) { profile->end(layer_phase); }
+    return true;
+}
+
+void FlipGraph::compute(const Code &center_code, int radius, int threads) {
+    graph_.clear();
+    codes_.clear();
+    parents_.clear();
+    flips_.clear();
+    automorphisms_.clear();
+    cache_.clear();
+    cache_positions_.clear();
+    n_ = center_code.symbol(0);
+    class_ = ::triangulation_class(n_, center_code.length() - n_ - 1);
+
+    // the neighbors are identified by their canonical codes, so the center
+    // must be as well
+    Code center = Code(Triangulation(center_code));
+
+    // visited triangulations of the previous, the current and the next layer
+    // with their indices. since flips are reversible, all neighbors of the
+    // current layer lie in one of these layers, as in layer_sizes.
+    CodeMap previous, current, next;
+    std::vector<const Code *> layer(1, &current.insert(std::make_pair(center, 0)).first->first);
+    std::vector<const Code *> next_layer;
+    std::vector<std::vector<Code> > neighbors;
+    ImplicitFlipGraph view;
+    graph_.push_back(std::vector<int>());
+    codes_.push_back(center);
+
+    // the triangulations of a layer have consecutive indices
+    int begin = 0;
+    for (int depth = 0; depth <= radius && !layer.empty(); ++depth) {
+        next_layer.clear();
+        int size = (int) layer.size();
+        for (int first = 0; first < size; first += LAYER_BLOCK_SIZE * threads) {
+            int last = std::min(size, first + LAYER_BLOCK_SIZE * threads);
+            expand_vertices(view, layer, first, last, threads, neighbors);
+
+            // add triangulations and edges
+            for (int i = 0; i < last - first; ++i) {
+                int index = begin + first + i;
+                for (const Code &code : neighbors[i]) {
+                    CodeMap::iterator it;
+                    int other_index = -1;
+                    if ((it = current.find(code)) != current.end()
+                        || (it = previous.find(code)) != previous.end()
+                        || (it = next.find(code)) != next.end()) {
+                        other_index = it->second;
+                    } else if (depth < radius) {
+                        other_index = (int) codes_.size();
+                        next_layer.push_back(&next.insert(std::make_pair(code, other_index)).first->first);
+                        graph_.push_back(std::vector<int>());
+                        codes_.push_back(code);
+                    }
+
+                    // add edge if not already present
+                    if (other_index >= 0 && index != other_index
+                        && std::count(graph_[index].begin(), graph_[index].end(), other_index) == 0) {
+                        graph_[index].push_back(other_index);
+                    }
+                }
+            }
+        }
+
+        // proceed with next layer. swapping the maps keeps their elements in
+        // place, so the pointers of the next layer stay valid
+        previous.swap(current);
+        current.swap(next);
+        next.clear();
+        layer.swap(next_layer);
+        begin += size;
+    }
+}
+
+void FlipGraph::set_memory_limit(long bytes) {
+    memory_limit_ = bytes;
+}
+
+void FlipGraph::set_triangulation_class(int triangulation_class) {
+    class_ = triangulation_class;
+}
+
+int FlipGraph::triangulation_class() const {
+    return class_;
+}
+
+const MemoryUsage &FlipGraph::memory_usage() const {
+    return memory_;
 }
 
 const Graph &FlipGraph::graph() const {
     return graph_;
 }
 
-const Code &FlipGraph::code(int i) const {
-    return codes_[i];
+Code FlipGraph::code(int i) const {
+    if (stores_codes()) { return Code(codes_[i]); }
+    return Code(rebuild(i));
+}
+
+bool FlipGraph::stores_codes() const {
+    return codes_.size() == graph_.size();
+}
+
+void FlipGraph::drop_codes() {
+    assert(has_parents());
+    codes_.clear();
+}
+
+const CodeTable &FlipGraph::codes() const {
+    assert(stores_codes());
+    return codes_;
+}
+
+bool FlipGraph::has_parents() const {
+    return !graph_.empty() && parents_.size() == graph_.size();
+}
+
+bool FlipGraph::has_automorphisms() const {
+    return automorphisms_.size() == graph_.size();
+}
+
+int FlipGraph::automorphisms(int i) const {
+    if (has_automorphisms()) { return automorphisms_[i]; }
+    return Code::automorphisms(Triangulation(Code(code(i))));
+}
+
+const Triangulation &FlipGraph::rebuild(int i) const {
+    assert(has_parents());
+    assert(i >= 0 && i < (int) graph_.size());
+
+    // collect flips up to the closest cached ancestor
+    std::vector<int> flips;
+    int j = i;
+    while (j >= 0 && cache_positions_.count(j) == 0) {
+        if (parents_[j] >= 0) { flips.push_back(flips_[j]); }
+        j = parents_[j];
+    }
+
+    if (j == i) {
+        // mark as most recently used
+        cache_.splice(cache_.begin(), cache_, cache_positions_[i]);
+        return cache_.front().second;
+    }
+
+    // replay flips on a copy of the ancestor
+    if (j >= 0) {
+        cache_.splice(cache_.begin(), cache_, cache_positions_[j]);
+        cache_.emplace_front(i, cache_.front().second);
+    } else {
+        cache_.emplace_front(i, Triangulation(n_, canonical_type(class_)));
+    }
+    Triangulation &triangulation = cache_.front().second;
+    for (int k = (int) flips.size() - 1; k >= 0; --k) {
+        triangulation.flip(triangulation.halfedge(flips[k]));
+    }
+    cache_positions_[i] = cache_.begin();
+
+    // evict least recently used triangulations
+    while (cache_.size() > TRIANGULATION_CACHE_SIZE) {
+        cache_positions_.erase(cache_.back().first);
+        cache_.pop_back();
+    }
+
+    return cache_.front().second;
+}
+
+void FlipGraph::flip_sequence(int i, std::vector<int> &flips) const {
+    assert(has_parents());
+    assert(i >= 0 && i < (int) graph_.size());
+
+    // the triangulations in the queue are copies of their parents, hence
+    // the halfedge indices are only valid when replayed from the root
+    flips.clear();
+    for (int j = i; parents_[j] >= 0; j = parents_[j]) { flips.push_back(flips_[j]); }
+    std::reverse(flips.begin(), flips.end());
 }
 
 void FlipGraph::write_to_stream(std::ostream &output_stream) const {
@@ -102,6 +693,95 @@ void FlipGraph::write_to_stream(std::ostream &output_stream) const {
     }
 }
 
+void FlipGraph::write_binary(std::ostream &output_stream) const {
+    // the header holds the magic, the number of vertices and the number
+    // of adjacency entries. it is followed by the degrees, the adjacency
+    // lists and the codes (all integers in native byte order).
+    uint32_t size = (uint32_t) graph_.size();
+    uint64_t entries = 0;
+    std::vector<uint32_t> degrees(size);
+    for (uint32_t i = 0; i < size; ++i) {
+        degrees[i] = (uint32_t) graph_[i].size();
+        entries += degrees[i];
+    }
+
+    output_stream.write(FLIP_GRAPH_MAGIC, 4);
+    output_stream.write((const char *) &size, 4);
+    output_stream.write((const char *) &entries, 8);
+    output_stream.write((const char *) degrees.data(), 4 * (std::streamsize) size);
+
+    std::vector<uint32_t> list;
+    for (uint32_t i = 0; i < size; ++i) {
+        list.assign(graph_[i].begin(), graph_[i].end());
+        output_stream.write((const char *) list.data(), 4 * (std::streamsize) list.size());
+    }
+
+    write_codes_binary(output_stream, codes_);
+
+    // the parent pointers are optional
+    if (has_parents()) {
+        std::vector<int32_t> parents(parents_.begin(), parents_.end());
+        output_stream.write((const char *) parents.data(), 4 * (std::streamsize) size);
+        output_stream.write((const char *) flips_.data(), 2 * (std::streamsize) size);
+    }
+}
+
+bool FlipGraph::read_binary(std::istream &input_stream) {
+    graph_.clear();
+    codes_.clear();
+    parents_.clear();
+    flips_.clear();
+    automorphisms_.clear();
+    cache_.clear();
+    cache_positions_.clear();
+
+    // read header
+    char magic[4];
+    uint32_t size;
+    uint64_t entries;
+    input_stream.read(magic, 4);
+    input_stream.read((char *) &size, 4);
+    input_stream.read((char *) &entries, 8);
+    if (!input_stream || memcmp(magic, FLIP_GRAPH_MAGIC, 4) != 0) { return false; }
+
+    // read adjacency lists
+    std::vector<uint32_t> degrees(size);
+    input_stream.read((char *) degrees.data(), 4 * (std::streamsize) size);
+    uint64_t sum = 0;
+    for (uint32_t degree : degrees) { sum += degree; }
+    if (!input_stream || sum != entries) { return false; }
+    graph_.resize(size);
+    std::vector<uint32_t> list;
+    for (uint32_t i = 0; i < size; ++i) {
+        list.resize(degrees[i]);
+        input_stream.read((char *) list.data(), 4 * (std::streamsize) list.size());
+        graph_[i].assign(list.begin(), list.end());
+        for (int neighbor : graph_[i]) {
+            if (neighbor < 0 || neighbor >= (int) size) { return false; }
+        }
+    }
+    if (!input_stream) { return false; }
+
+    // read codes
+    if (!read_codes_binary(input_stream, codes_)) { return false; }
+    if (codes_.size() != size) { return false; }
+    n_ = (size > 0) ? codes_[0].symbol(0) : 0;
+    class_ = (size > 0) ? ::triangulation_class(n_, codes_.length() - n_ - 1) : CLASS_PLANAR;
+
+    // read parent pointers if present
+    if (input_stream.peek() == std::char_traits<char>::eof()) { return true; }
+    std::vector<int32_t> parents(size);
+    flips_.resize(size);
+    input_stream.read((char *) parents.data(), 4 * (std::streamsize) size);
+    input_stream.read((char *) flips_.data(), 2 * (std::streamsize) size);
+    if (!input_stream) { return false; }
+    for (uint32_t i = 0; i < size; ++i) {
+        if (parents[i] >= (int32_t) i || (parents[i] < 0) != (i == 0)) { return false; }
+    }
+    parents_.assign(parents.begin(), parents.end());
+    return true;
+}
+
 /* ---------------------------------------------------------------------- *
  * end of file
  * ---------------------------------------------------------------------- */
\ No newline at end of file
@@ -6,8 +6,17 @@
 #define __FGG_FLIP_GRAPH__
 
 #include "triangulation.hpp"
+#include "codetable.hpp"
+#include "memory.hpp"
 
 #include <vector>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <iostream>
+
+class Profile;
+class Progress;
 
 /* ---------------------------------------------------------------------- *
  * definition of the flip graph class
@@ -16,20 +25,138 @@
 class FlipGraph {
 public:
     typedef std::vector<std::vector<int> > Graph;
-    typedef std::vector<Code> CodeList;
+
+    // constructor that creates an empty flip graph
+    FlipGraph();
 
 private:
     Graph graph_;
-    CodeList codes_;
+    CodeTable codes_;
+
+    // the index of the triangulation each triangulation was discovered from
+    // (-1 for the canonical triangulation)
+    std::vector<int> parents_;
+
+    // the index of the halfedge whose flip discovered each triangulation
+    std::vector<unsigned short> flips_;
+
+    // the number of automorphisms of each triangulation, which is counted
+    // while computing its code
+    std::vector<unsigned short> automorphisms_;
+
+    // the number of vertices
+    int n_;
+
+    // the class of the triangulations
+    int class_;
+
+    // the memory limit of compute in bytes (0 if there is none)
+    long memory_limit_;
+
+    // the accounted memory at the peak of the last computation
+    MemoryUsage memory_;
+
+    // the triangulations that have recently been rebuilt by code(i) if the
+    // codes are not stored, most recently used first
+    mutable std::list<std::pair<int, Triangulation> > cache_;
+
+    // the positions of the cached triangulations in cache_
+    mutable std::unordered_map<int, std::list<std::pair<int, Triangulation> >::iterator> cache_positions_;
+
+    // rebuilds the i-th triangulation by replaying flips from the closest
+    // cached ancestor in the search tree
+    const Triangulation &rebuild(int i) const;
 
 public:
-    void compute(int n);
+    // computes the flip graph on n vertices. the map from codes to indices
+    // refers to the stored codes, so the codes are dropped at the end if
+    // store_codes is false, after which only the search tree is kept and
+    // codes are rebuilt on demand. if a profile is given, the layers of the
+    // search as well as the time spent on flipping, coding and looking up
+    // codes are recorded in it. if a progress reporter is given, the state
+    // of the search is reported periodically. if the accounted memory
+    // approaches the memory limit, the queued triangulations are replaced
+    // by their indices, which are rebuilt from the search tree when they
+    // are expanded. returns false if the limit is exceeded nevertheless, in
+    // which case the graph is incomplete.
+    bool compute(int n, bool store_codes = true, Profile *profile = nullptr, Progress *progress = nullptr);
+
+    // computes the flip graph of the outerplanar triangulations on n
+    // vertices (at most MAX_POLYGON_ORDER) by flipping diagonals of
+    // triangulated polygons, which takes constant time, and identifying
+    // rotations by the keys of the polygons. the graph equals the one of
+    // compute(n), since the diagonals are flipped in the order of the
+    // halfedges, so the indices and the search tree agree as well.
+    // the search tree is recorded with the halfedges of the triangulations
+    // that rebuild() replays, and the codes are only computed if
+    // store_codes is true (otherwise they are rebuilt on demand). the
+    // profile and the progress reporter are handled as by compute(n). if the
+    // accounted memory approaches the memory limit, the codes are dropped
+    // (the queue is never degraded), and false is returned if the limit is
+    // exceeded nevertheless.
+    bool compute_polygons(int n, bool store_codes = true, Profile *profile = nullptr,
+                          Progress *progress = nullptr);
+
+    // computes the subgraph of the flip graph induced by all triangulations
+    // within the specified distance of the triangulation with the specified
+    // code (which need not be canonical), which gets index 0. only the last
+    // three layers are kept in the set of visited triangulations and the
+    // neighbors of every layer are computed by the specified number of
+    // threads. no parent pointers are recorded.
+    void compute(const Code &center, int radius, int threads = 1);
+
+    // sets the memory limit of compute(n) and compute_polygons in bytes (0
+    // for no limit)
+    void set_memory_limit(long bytes);
+
+    // sets the class of the triangulations whose flip graph is computed by
+    // compute(n) (planar by default)
+    void set_triangulation_class(int triangulation_class);
+
+    // returns the class of the triangulations
+    int triangulation_class() const;
+
+    // returns the accounted memory at the peak of the last computation
+    const MemoryUsage &memory_usage() const;
 
     const Graph &graph() const;
 
-    const Code &code(int i) const;
+    // returns the code of the i-th triangulation. if the codes are not
+    // stored, the code is rebuilt from the search tree.
+    Code code(int i) const;
+
+    // returns true if the codes of all triangulations are stored
+    bool stores_codes() const;
+
+    // frees the stored codes, which are rebuilt on demand afterwards
+    void drop_codes();
+
+    const CodeTable &codes() const;
+
+    // returns true if the parent pointers of the search tree are known
+    bool has_parents() const;
+
+    // returns true if the automorphisms of all triangulations are stored,
+    // which is the case after compute(n) and compute_polygons
+    bool has_automorphisms() const;
+
+    // returns the number of automorphisms of the i-th triangulation. if
+    // they are not stored, it is computed from the code.
+    int automorphisms(int i) const;
+
+    // computes the indices of the halfedges that have to be flipped one
+    // after another to obtain the i-th triangulation from the canonical
+    // triangulation on the same vertices. the flip sequence is shortest.
+    void flip_sequence(int i, std::vector<int> &flips) const;
 
     void write_to_stream(std::ostream &output_stream) const;
+
+    // writes the graph, the codes and the parent pointers in binary format
+    void write_binary(std::ostream &output_stream) const;
+
+    // reads a flip graph written by write_binary. returns false if the
+    // stream does not contain a valid flip graph.
+    bool read_binary(std::istream &input_stream);
 };
 
 #endif
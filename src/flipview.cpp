@@ -0,0 +1,129 @@
+/* ---------------------------------------------------------------------- *
+ * flipview.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "flipview.hpp"
+
+#include <thread>
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the explicit flip graph class
+ * ---------------------------------------------------------------------- */
+
+ExplicitFlipGraph::ExplicitFlipGraph(const Graph &graph) {
+    int size = (int) graph.size();
+    offsets_.resize(size + 1);
+    offsets_[0] = 0;
+    for (int i = 0; i < size; ++i) { offsets_[i + 1] = offsets_[i] + (int) graph[i].size(); }
+    targets_.reserve(offsets_[size]);
+    for (int i = 0; i < size; ++i) { targets_.insert(targets_.end(), graph[i].begin(), graph[i].end()); }
+}
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the implicit flip graph class
+ * ---------------------------------------------------------------------- */
+
+ImplicitFlipGraph::ImplicitFlipGraph() : triangulation_(4), code_(triangulation_) {
+}
+
+ImplicitFlipGraph::NeighborRange ImplicitFlipGraph::neighbors(const Code &code) {
+    triangulation_.assign(code);
+    return NeighborRange(this);
+}
+
+int ImplicitFlipGraph::NeighborRange::advance(int i) {
+    Triangulation &triangulation = view_->triangulation_;
+    int m = triangulation.size();
+    for (; i < m; ++i) {
+        Halfedge *halfedge = triangulation.halfedge(i);
+        if (triangulation.is_representative(halfedge) && triangulation.is_flippable(halfedge)) {
+            // flipping twice restores all halfedge indices
+            triangulation.flip(halfedge);
+            view_->code_.assign(triangulation);
+            triangulation.flip(halfedge);
+            return i;
+        }
+    }
+    return m;
+}
+
+/* ---------------------------------------------------------------------- *
+ * graph kernels
+ * ---------------------------------------------------------------------- */
+
+// computes the neighbors of the codes in [begin, end) of the list and
+// stores them relative to the specified offset
+static void compute_neighbors(ImplicitFlipGraph &view, const std::vector<const Code *> &codes, int begin, int end,
+                              int offset, std::vector<std::vector<Code> > &neighbors) {
+    for (int i = begin; i < end; ++i) {
+        std::vector<Code> &list = neighbors[i - offset];
+        list.clear();
+        for (const Code &code : view.neighbors(*codes[i])) { list.push_back(code); }
+    }
+}
+
+// computes the neighbors like compute_neighbors on a view of its own
+static void compute_neighbors_worker(const std::vector<const Code *> *codes, int begin, int end, int offset,
+                                     std::vector<std::vector<Code> > *neighbors) {
+    ImplicitFlipGraph view;
+    compute_neighbors(view, *codes, begin, end, offset, *neighbors);
+}
+
+void expand_vertices(ImplicitFlipGraph &view, const std::vector<const Code *> &codes, int begin, int end,
+                     int threads, std::vector<std::vector<Code> > &neighbors) {
+    int count = end - begin;
+    neighbors.resize(count);
+    if (threads <= 1 || count < 2 * threads) {
+        compute_neighbors(view, codes, begin, end, begin, neighbors);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    int chunk = (count + threads - 1) / threads;
+    for (int first = begin; first < end; first += chunk) {
+        int last = std::min(end, first + chunk);
+        workers.push_back(std::thread(compute_neighbors_worker, &codes, first, last, begin, &neighbors));
+    }
+    for (std::thread &worker : workers) { worker.join(); }
+}
+
+void distance_list(ExplicitFlipGraph &view, const std::vector<int> &sources, std::vector<int> &distances) {
+    int size = view.size();
+    distances.assign(size, -1);
+
+    // the vertices in order of their discovery serve as queue
+    std::vector<int> queue;
+    queue.reserve(size);
+    for (int source : sources) {
+        if (distances[source] < 0) {
+            distances[source] = 0;
+            queue.push_back(source);
+        }
+    }
+    for (int i = 0; i < (int) queue.size(); ++i) {
+        int vertex = queue[i];
+        for (int neighbor : view.neighbors(vertex)) {
+            if (distances[neighbor] < 0) {
+                distances[neighbor] = distances[vertex] + 1;
+                queue.push_back(neighbor);
+            }
+        }
+    }
+}
+
+int eccentricity(ExplicitFlipGraph &view, int vertex) {
+    std::vector<int> distances;
+    distance_list(view, std::vector<int>(1, vertex), distances);
+    return *std::max_element(distances.begin(), distances.end());
+}
+
+int graph_diameter(ExplicitFlipGraph &view) {
+    int size = view.size();
+    int result = 0;
+    for (int i = 0; i < size; ++i) { result = std::max(result, eccentricity(view, i)); }
+    return result;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,370 @@
+/* ---------------------------------------------------------------------- *
+ * flipview.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_FLIP_VIEW__
+#define __FGG_FLIP_VIEW__
+
+#include "triangulation.hpp"
+#include "codeindex.hpp"
+
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <algorithm>
+
+/* ---------------------------------------------------------------------- *
+ * graph views
+ *
+ * the graph kernels below work on any graph view that provides
+ *
+ *   Vertex                 the type of a vertex
+ *   VertexMap<T>           an associative container from vertices to T
+ *   neighbors(vertex)      a range of the vertex's neighbors
+ *
+ * the explicit view stores a generated graph, whose vertices are indices,
+ * in compressed sparse row format, while the implicit view computes the
+ * neighbors of a code on the fly, so no flip graph has to be generated
+ * beforehand.
+ * ---------------------------------------------------------------------- */
+
+class ExplicitFlipGraph {
+public:
+    typedef std::vector<std::vector<int> > Graph;
+    typedef int Vertex;
+    template <class T> using VertexMap = std::unordered_map<int, T>;
+
+    // the range of the neighbors of a vertex
+    class NeighborRange {
+    public:
+        NeighborRange(const int *begin, const int *end) : begin_(begin), end_(end) {}
+
+        const int *begin() const { return begin_; }
+
+        const int *end() const { return end_; }
+
+    private:
+        // the first and one past the last neighbor
+        const int *begin_;
+        const int *end_;
+    };
+
+    // constructor that converts the specified adjacency lists into
+    // compressed sparse row format
+    ExplicitFlipGraph(const Graph &graph);
+
+private:
+    // the start of each vertex's neighbors in targets (size + 1 entries)
+    std::vector<int> offsets_;
+
+    // the neighbors of all vertices
+    std::vector<int> targets_;
+
+public:
+    // returns the number of vertices
+    int size() const { return (int) offsets_.size() - 1; }
+
+    // returns the neighbors of the specified vertex
+    NeighborRange neighbors(int vertex) const {
+        return NeighborRange(targets_.data() + offsets_[vertex], targets_.data() + offsets_[vertex + 1]);
+    }
+};
+
+class ImplicitFlipGraph {
+public:
+    typedef Code Vertex;
+    template <class T> using VertexMap = std::unordered_map<Code, T, CodeHash>;
+
+    // the range of the neighbors of a code. the neighbors are computed one
+    // after another while iterating by flipping the representative
+    // flippable halfedges of a scratch triangulation. a neighbor may occur
+    // several times. only one range of a view may be used at a time.
+    class NeighborRange {
+    public:
+        class iterator {
+        public:
+            iterator(NeighborRange *range, int index) : range_(range), index_(index) {}
+
+            const Code &operator*() const { return range_->view_->code_; }
+
+            const Code *operator->() const { return &range_->view_->code_; }
+
+            iterator &operator++() {
+                index_ = range_->advance(index_ + 1);
+                return *this;
+            }
+
+            bool operator==(const iterator &other) const { return index_ == other.index_; }
+
+            bool operator!=(const iterator &other) const { return index_ != other.index_; }
+
+        private:
+            // the range
+            NeighborRange *range_;
+
+            // the index of the halfedge whose flip yields the current neighbor
+            int index_;
+        };
+
+        NeighborRange(ImplicitFlipGraph *view) : view_(view) {}
+
+        iterator begin() { return iterator(this, advance(0)); }
+
+        iterator end() { return iterator(this, view_->triangulation_.size()); }
+
+    private:
+        // the view
+        ImplicitFlipGraph *view_;
+
+        // computes the neighbor obtained by flipping the first representative
+        // flippable halfedge with index at least i and returns its index
+        int advance(int i);
+    };
+
+    // constructor
+    ImplicitFlipGraph();
+
+private:
+    // the scratch triangulation
+    Triangulation triangulation_;
+
+    // the code of the current neighbor
+    Code code_;
+
+public:
+    // returns the neighbors of the triangulation with the specified code
+    NeighborRange neighbors(const Code &code);
+};
+
+/* ---------------------------------------------------------------------- *
+ * graph kernels
+ *
+ * the kernels expand a layer in blocks of LAYER_BLOCK_SIZE vertices per
+ * thread. the neighbors of a block are computed by expand_vertices, which
+ * is sequential for any view except the implicit one, whose overload
+ * splits the block over the specified number of threads.
+ * ---------------------------------------------------------------------- */
+
+// the number of vertices per thread whose neighbors are computed at once
+const int LAYER_BLOCK_SIZE = 1024;
+
+// computes the neighbors of the vertices in [begin, end) of the specified
+// list and stores the neighbors of the i-th vertex in neighbors[i - begin]
+template <class View>
+void expand_vertices(View &view, const std::vector<const typename View::Vertex *> &vertices, int begin, int end,
+                     int threads, std::vector<std::vector<typename View::Vertex> > &neighbors) {
+    typedef typename View::Vertex Vertex;
+    neighbors.resize(end - begin);
+    for (int i = begin; i < end; ++i) {
+        std::vector<Vertex> &list = neighbors[i - begin];
+        list.clear();
+        for (const Vertex &neighbor : view.neighbors(*vertices[i])) { list.push_back(neighbor); }
+    }
+}
+
+// computes the neighbors of the codes in [begin, end) of the specified list
+// using the specified number of threads, each of which flips on its own
+// scratch triangulation
+void expand_vertices(ImplicitFlipGraph &view, const std::vector<const Code *> &codes, int begin, int end,
+                     int threads, std::vector<std::vector<Code> > &neighbors);
+
+// the tree of a breadth first search. the vertices are stored in order of
+// their discovery, so every layer is a contiguous range.
+template <class View>
+struct SearchTree {
+    typedef typename View::Vertex Vertex;
+
+    // the indices of all vertices discovered so far
+    typename View::template VertexMap<int> indices;
+
+    // the vertices in order of their discovery (the keys of indices)
+    std::vector<const Vertex *> vertices;
+
+    // the index of the vertex each vertex was discovered from
+    std::vector<int> parents;
+
+    // the index of the first vertex of the current layer and its distance
+    // from the root
+    int layer_begin;
+    int depth;
+
+    SearchTree() : layer_begin(0), depth(0) {}
+
+    // adds the specified vertex unless it is already known
+    void add(const Vertex &vertex, int parent) {
+        std::pair<typename View::template VertexMap<int>::iterator, bool> result
+                = indices.insert(std::make_pair(vertex, (int) vertices.size()));
+        if (result.second) {
+            vertices.push_back(&result.first->first);
+            parents.push_back(parent);
+        }
+    }
+
+    // appends the vertices from the specified vertex to the root
+    void trace(int index, std::vector<Vertex> &path) const {
+        for (; index >= 0; index = parents[index]) { path.push_back(*vertices[index]); }
+    }
+};
+
+// computes the number of vertices at each distance up to the specified
+// radius (or all distances if the radius is negative) from the source.
+// since the graph is undirected, all neighbors of a layer lie in the
+// previous, the same or the next layer, so only three layers are kept.
+template <class View>
+void layer_sizes(View &view, const typename View::Vertex &source, int radius, std::vector<long> &layers,
+                 int threads = 1) {
+    typedef typename View::Vertex Vertex;
+    typedef typename View::template VertexMap<bool> VertexSet;
+    VertexSet previous, current, next;
+    std::vector<const Vertex *> layer(1, &current.insert(std::make_pair(source, true)).first->first);
+    std::vector<const Vertex *> next_layer;
+    std::vector<std::vector<Vertex> > neighbors;
+
+    layers.clear();
+    while (!layer.empty()) {
+        layers.push_back((long) layer.size());
+        if ((int) layers.size() > radius && radius >= 0) { break; }
+
+        next_layer.clear();
+        int size = (int) layer.size();
+        for (int first = 0; first < size; first += LAYER_BLOCK_SIZE * threads) {
+            int last = std::min(size, first + LAYER_BLOCK_SIZE * threads);
+            expand_vertices(view, layer, first, last, threads, neighbors);
+            for (int i = 0; i < last - first; ++i) {
+                for (const Vertex &neighbor : neighbors[i]) {
+                    if (previous.count(neighbor) > 0 || current.count(neighbor) > 0) { continue; }
+                    std::pair<typename VertexSet::iterator, bool> result
+                            = next.insert(std::make_pair(neighbor, true));
+                    if (result.second) { next_layer.push_back(&result.first->first); }
+                }
+            }
+        }
+
+        // swapping the sets keeps their elements in place
+        previous.swap(current);
+        current.swap(next);
+        next.clear();
+        layer.swap(next_layer);
+    }
+}
+
+// computes the distances of all vertices within the specified radius (or
+// of all vertices if the radius is negative) to the nearest of the
+// specified sources. vertices farther away are not contained in distances.
+template <class View>
+void distance_list(View &view, const std::vector<typename View::Vertex> &sources,
+                   typename View::template VertexMap<int> &distances, int radius = -1, int threads = 1) {
+    typedef typename View::Vertex Vertex;
+    typedef typename View::template VertexMap<int> DistanceMap;
+    std::vector<const Vertex *> layer;
+    std::vector<const Vertex *> next_layer;
+    std::vector<std::vector<Vertex> > neighbors;
+
+    distances.clear();
+    for (const Vertex &source : sources) {
+        std::pair<typename DistanceMap::iterator, bool> result = distances.insert(std::make_pair(source, 0));
+        if (result.second) { layer.push_back(&result.first->first); }
+    }
+
+    for (int depth = 1; !layer.empty() && (radius < 0 || depth <= radius); ++depth) {
+        next_layer.clear();
+        int size = (int) layer.size();
+        for (int first = 0; first < size; first += LAYER_BLOCK_SIZE * threads) {
+            int last = std::min(size, first + LAYER_BLOCK_SIZE * threads);
+            expand_vertices(view, layer, first, last, threads, neighbors);
+            for (int i = 0; i < last - first; ++i) {
+                for (const Vertex &neighbor : neighbors[i]) {
+                    std::pair<typename DistanceMap::iterator, bool> result
+                            = distances.insert(std::make_pair(neighbor, depth));
+                    if (result.second) { next_layer.push_back(&result.first->first); }
+                }
+            }
+        }
+        layer.swap(next_layer);
+    }
+}
+
+// returns the eccentricity of the specified vertex, i.e., its largest
+// distance to any other vertex
+template <class View>
+int eccentricity(View &view, const typename View::Vertex &vertex, int threads = 1) {
+    std::vector<long> layers;
+    layer_sizes(view, vertex, -1, layers, threads);
+    return (int) layers.size() - 1;
+}
+
+// computes the distances of all vertices of the explicit view to the
+// nearest of the specified sources (-1 if a vertex is not reachable).
+// unlike the generic kernel, the distances are stored in a list that is
+// indexed by the vertices.
+void distance_list(ExplicitFlipGraph &view, const std::vector<int> &sources, std::vector<int> &distances);
+
+// returns the eccentricity of the specified vertex of the explicit view
+int eccentricity(ExplicitFlipGraph &view, int vertex);
+
+// returns the diameter of the explicit view
+int graph_diameter(ExplicitFlipGraph &view);
+
+// computes the distance between the two specified vertices by a breadth
+// first search from both vertices that always expands the smaller layer.
+// returns -1 if the vertices are not connected. if path is not null, the
+// vertices of a shortest path from vertex_a to vertex_b are stored in it.
+template <class View>
+int bidirectional_distance(View &view, const typename View::Vertex &vertex_a, const typename View::Vertex &vertex_b,
+                           std::vector<typename View::Vertex> *path = nullptr, int threads = 1) {
+    typedef typename View::Vertex Vertex;
+    if (path != nullptr) { path->clear(); }
+    if (vertex_a == vertex_b) {
+        if (path != nullptr) { path->push_back(vertex_a); }
+        return 0;
+    }
+
+    SearchTree<View> trees[2];
+    std::vector<std::vector<Vertex> > neighbors;
+    trees[0].add(vertex_a, -1);
+    trees[1].add(vertex_b, -1);
+
+    while (true) {
+        int sizes[2];
+        for (int side = 0; side < 2; ++side) {
+            sizes[side] = (int) trees[side].vertices.size() - trees[side].layer_begin;
+        }
+        if (sizes[0] == 0 || sizes[1] == 0) { return -1; }
+
+        int side = (sizes[0] <= sizes[1]) ? 0 : 1;
+        SearchTree<View> &own = trees[side];
+        const SearchTree<View> &other = trees[1 - side];
+        int begin = own.layer_begin;
+        int end = (int) own.vertices.size();
+        for (int first = begin; first < end; first += LAYER_BLOCK_SIZE * threads) {
+            int last = std::min(end, first + LAYER_BLOCK_SIZE * threads);
+            expand_vertices(view, own.vertices, first, last, threads, neighbors);
+
+            // the first neighbor that is found in the other tree yields a
+            // shortest path, since it lies in the other tree's last layer
+            for (int i = first; i < last; ++i) {
+                for (const Vertex &neighbor : neighbors[i - first]) {
+                    typename View::template VertexMap<int>::const_iterator it = other.indices.find(neighbor);
+                    if (it == other.indices.end()) {
+                        own.add(neighbor, i);
+                        continue;
+                    }
+                    if (path != nullptr) {
+                        trees[0].trace((side == 0) ? i : it->second, *path);
+                        std::reverse(path->begin(), path->end());
+                        trees[1].trace((side == 0) ? it->second : i, *path);
+                    }
+                    return own.depth + 1 + other.depth;
+                }
+            }
+        }
+        own.layer_begin = end;
+        own.depth++;
+    }
+}
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
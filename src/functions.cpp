@@ -3,8 +3,8 @@
  * ---------------------------------------------------------------------- */
 
 #include "functions.hpp"
+#include "flipview.hpp"
 
-#include <queue>
 #include <utility>
 #include <climits>
 
@@ -42,34 +42,8 @@ void distance_list(const Graph &graph, int vertex, std::vector<int> &distances)
 }
 
 void distance_list(const Graph &graph, std::vector<int> &vertices, std::vector<int> &distances) {
-    int n = static_cast<int>(graph.size());
-
-    distances.clear();
-    distances.resize(n, -1);
-
-    std::queue<std::pair<int, int> > queue;
-    for (int vertex : vertices) {
-        if (distances[vertex] == -1) {
-            distances[vertex] = 0;
-            //queue.push(std::make_pair(vertex, 0));
-            queue.push({vertex, 0});
-        }
-    }
-
-    while (!queue.empty()) {
-        int vertex = queue.front().first;
-        int distance = queue.front().second;
-        queue.pop();
-
-        int degree = (int) graph[vertex].size();
-        for (int i = 0; i < degree; ++i) {
-            int neighbor = graph[vertex][i];
-            if (distances[neighbor] == -1) {
-                distances[neighbor] = distance + 1;
-                queue.push({neighbor, distance + 1});
-            }
-        }
-    }
+    ExplicitFlipGraph view(graph);
+    distance_list(view, vertices, distances);
 }
 
 void distance_histogram(const Graph &graph, int vertex, std::vector<int> &histogram) {
@@ -84,27 +58,13 @@ void distance_histogram(const Graph &graph, std::vector<int> &vertices, std::vec
 }
 
 int eccentricity(const Graph &graph, int vertex) {
-    std::vector<int> distances;
-    distance_list(graph, vertex, distances);
-
-    int n = (int) graph.size();
-    int result = 0;
-    for (int i = 0; i < n; ++i) {
-        result = std::max(result, distances[i]);
-    }
-
-    return result;
+    ExplicitFlipGraph view(graph);
+    return eccentricity(view, vertex);
 }
 
 int graph_diameter(const Graph &graph) {
-    int n = (int) graph.size();
-    int result = 0;
-
-    for (int i = 0; i < n; ++i) {
-        result = std::max(result, eccentricity(graph, i));
-    }
-
-    return result;
+    ExplicitFlipGraph view(graph);
+    return graph_diameter(view);
 }
 
 /* ---------------------------------------------------------------------- *
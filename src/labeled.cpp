@@ -0,0 +1,213 @@
+/* ---------------------------------------------------------------------- *
+ * labeled.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "labeled.hpp"
+#include "triangulation.hpp"
+
+#include <utility>
+#include <cassert>
+
+/* ---------------------------------------------------------------------- *
+ * edge sets
+ * ---------------------------------------------------------------------- */
+
+// returns the bit of the edge between the vertices with the specified
+// labels (0 to n - 1) in an edge set
+static inline uint64_t edge_bit(int a, int b) {
+    if (a > b) { std::swap(a, b); }
+    return 1ULL << (b * (b - 1) / 2 + a);
+}
+
+// returns the bit of the edge of the specified halfedge
+static inline uint64_t edge_bit(Halfedge *halfedge) {
+    return edge_bit(halfedge->target()->label(), halfedge->twin()->target()->label());
+}
+
+// returns the number of flippable edges of the specified triangulation
+static int flippable_edges(const Triangulation &triangulation) {
+    int count = 0;
+    int m = triangulation.size();
+    for (int i = 0; i < m; ++i) {
+        Halfedge *halfedge = triangulation.halfedge(i);
+        if (triangulation.is_representative(halfedge) && triangulation.is_flippable(halfedge)) { count++; }
+    }
+    return count;
+}
+
+/* ---------------------------------------------------------------------- *
+ * edge set hash set
+ *
+ * an open addressing hash set with linear probing for nonzero edge sets.
+ * the table is at most half full, hence probes are short, and every entry
+ * is a single word without any allocation.
+ * ---------------------------------------------------------------------- */
+
+class EdgeSetTable {
+public:
+    EdgeSetTable() : slots_(1024, 0), size_(0) {}
+
+    // inserts the edge set and returns false if it was already contained
+    bool insert(uint64_t edges) {
+        if (2 * (size_ + 1) > slots_.size()) { grow(); }
+        return place(slots_, edges);
+    }
+
+    // returns the number of edge sets
+    uint64_t size() const { return size_; }
+
+private:
+    std::vector<uint64_t> slots_;
+    uint64_t size_;
+
+    static uint64_t hash(uint64_t value) {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= value >> 33;
+        return value;
+    }
+
+    bool place(std::vector<uint64_t> &slots, uint64_t edges) {
+        uint64_t mask = slots.size() - 1;
+        for (uint64_t slot = hash(edges) & mask;; slot = (slot + 1) & mask) {
+            if (slots[slot] == edges) { return false; }
+            if (slots[slot] == 0) {
+                slots[slot] = edges;
+                size_++;
+                return true;
+            }
+        }
+    }
+
+    void grow() {
+        std::vector<uint64_t> slots(2 * slots_.size(), 0);
+        size_ = 0;
+        for (uint64_t edges : slots_) {
+            if (edges != 0) { place(slots, edges); }
+        }
+        slots_.swap(slots);
+    }
+};
+
+/* ---------------------------------------------------------------------- *
+ * labeled flip graphs
+ * ---------------------------------------------------------------------- */
+
+void labeled_counts(const FlipGraph &flip_graph, LabeledCounts &counts) {
+    int size = (int) flip_graph.graph().size();
+    counts.triangulations = 0;
+    counts.edges = 0;
+    counts.degrees.clear();
+    if (size == 0) { return; }
+
+    int n = flip_graph.code(0).symbol(0);
+    uint64_t factorial = 1;
+    for (int i = 2; i <= n; ++i) { factorial *= i; }
+
+    // the edges are counted from both of their triangulations and the
+    // automorphisms are stored by the flip graph
+    uint64_t edge_ends = 0;
+    for (int i = 0; i < size; ++i) {
+        Triangulation triangulation(flip_graph.code(i));
+        uint64_t labelings = factorial / flip_graph.automorphisms(i);
+        int degree = flippable_edges(triangulation);
+
+        counts.triangulations += labelings;
+        edge_ends += labelings * degree;
+        if ((int) counts.degrees.size() <= degree) { counts.degrees.resize(degree + 1, 0); }
+        counts.degrees[degree] += labelings;
+    }
+    counts.edges = edge_ends / 2;
+}
+
+void explore_labeled(int n, LabeledCounts &counts, std::vector<uint64_t> &layers) {
+    assert(n >= 4 && n <= MAX_LABELED_ORDER);
+    counts.triangulations = 0;
+    counts.edges = 0;
+    counts.degrees.clear();
+    layers.clear();
+
+    // the labels of the vertices are never changed by flips
+    Triangulation triangulation(n);
+    for (int i = 0; i < n; ++i) { triangulation.vertex(i)->set_label(i); }
+    uint64_t edges = 0;
+    for (int i = 0; i < triangulation.size(); ++i) { edges |= edge_bit(triangulation.halfedge(i)); }
+
+    // the search tree, whose triangulations are numbered in breadth first
+    // order. the scratch triangulation is moved from one triangulation to
+    // the next one by undoing and replaying the flips of the tree, since a
+    // flip is undone by flipping the same halfedge again.
+    EdgeSetTable visited;
+    visited.insert(edges);
+    std::vector<uint32_t> parents(1, 0);
+    std::vector<unsigned char> flips(1, 0);
+    std::vector<unsigned char> path;
+    uint32_t position = 0;
+
+    uint64_t edge_ends = 0;
+    uint32_t layer_begin = 0;
+    while (layer_begin < parents.size()) {
+        uint32_t layer_end = (uint32_t) parents.size();
+        layers.push_back(layer_end - layer_begin);
+
+        for (uint32_t index = layer_begin; index < layer_end; ++index) {
+            // the node with the larger index is not closer to the root,
+            // hence both meet at their lowest common ancestor
+            uint32_t target = index;
+            path.clear();
+            while (position != target) {
+                if (position > target) {
+                    Halfedge *halfedge = triangulation.halfedge(flips[position]);
+                    uint64_t old_edge = edge_bit(halfedge);
+                    triangulation.flip_unchecked(halfedge);
+                    edges ^= old_edge ^ edge_bit(halfedge);
+                    position = parents[position];
+                } else {
+                    path.push_back(flips[target]);
+                    target = parents[target];
+                }
+            }
+            for (int i = (int) path.size() - 1; i >= 0; --i) {
+                Halfedge *halfedge = triangulation.halfedge(path[i]);
+                uint64_t old_edge = edge_bit(halfedge);
+                triangulation.flip_unchecked(halfedge);
+                edges ^= old_edge ^ edge_bit(halfedge);
+            }
+            position = index;
+
+            // the edge set changes by the flipped edge only
+            int degree = 0;
+            int m = triangulation.size();
+            for (int i = 0; i < m; ++i) {
+                Halfedge *halfedge = triangulation.halfedge(i);
+                if (!triangulation.is_representative(halfedge) || !triangulation.is_flippable(halfedge)) {
+                    continue;
+                }
+                degree++;
+                uint64_t old_edge = edge_bit(halfedge);
+                triangulation.flip_unchecked(halfedge);
+                uint64_t other = edges ^ old_edge ^ edge_bit(halfedge);
+                if (visited.insert(other)) {
+                    parents.push_back(index);
+                    flips.push_back((unsigned char) i);
+                }
+                triangulation.flip_unchecked(halfedge);
+            }
+
+            edge_ends += degree;
+            if ((int) counts.degrees.size() <= degree) { counts.degrees.resize(degree + 1, 0); }
+            counts.degrees[degree]++;
+        }
+
+        layer_begin = layer_end;
+    }
+
+    counts.triangulations = visited.size();
+    counts.edges = edge_ends / 2;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,67 @@
+/* ---------------------------------------------------------------------- *
+ * labeled.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_LABELED__
+#define __FGG_LABELED__
+
+#include "flipgraph.hpp"
+
+#include <vector>
+#include <cstdint>
+
+/* ---------------------------------------------------------------------- *
+ * constants
+ * ---------------------------------------------------------------------- */
+
+// the maximal number of vertices of the explicit labeled search. there are
+// about 10^7 labeled triangulations on 9 vertices, but already about 6 *
+// 10^8 on 10 vertices, whose edge sets and search tree exceed the memory.
+const int MAX_LABELED_ORDER = 9;
+
+/* ---------------------------------------------------------------------- *
+ * labeled flip graphs
+ *
+ * the labeled flip graph has a vertex for every triangulation whose
+ * vertices are labeled 1 to n, i.e., for every edge set of a triangulation
+ * on these labels. an unlabeled triangulation t with a(t) automorphisms
+ * (including orientation reversing ones) has n! / a(t) labelings, and a
+ * labeled triangulation has one neighbor for every flippable edge, since
+ * flips of different edges yield different edge sets. hence, the number
+ * of labeled triangulations, the number of edges and the degree histogram
+ * of the labeled flip graph are sums over the unlabeled triangulations and
+ * the labeled flip graph is never built.
+ *
+ * distances are not determined by the unlabeled flip graph, so they are
+ * computed by an explicit breadth first search over labeled triangulations
+ * that are identified by their edge sets, which need no canonical codes.
+ * only the edge sets and the search tree (the parent and the flipped
+ * halfedge of every labeled triangulation) are stored, and a single
+ * triangulation walks along the tree. this is only feasible for small n.
+ * ---------------------------------------------------------------------- */
+
+struct LabeledCounts {
+    // the number of labeled triangulations
+    uint64_t triangulations;
+
+    // the number of edges of the labeled flip graph
+    uint64_t edges;
+
+    // the number of labeled triangulations of every degree
+    std::vector<uint64_t> degrees;
+};
+
+// computes the counts of the labeled flip graph from the triangulations of
+// the specified unlabeled flip graph
+void labeled_counts(const FlipGraph &flip_graph, LabeledCounts &counts);
+
+// computes the counts of the labeled flip graph on n vertices (at most
+// MAX_LABELED_ORDER) by an explicit search from the canonical triangulation
+// as well as the number of labeled triangulations at each distance from it
+void explore_labeled(int n, LabeledCounts &counts, std::vector<uint64_t> &layers);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,74 @@
+/* ---------------------------------------------------------------------- *
+ * memory.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "memory.hpp"
+#include "estimate.hpp"
+
+#include <utility>
+#include <vector>
+#include <cstdlib>
+
+/* ---------------------------------------------------------------------- *
+ * constants
+ * ---------------------------------------------------------------------- */
+
+// the largest fraction of all triangulations that is queued at once
+const double FRONTIER_FRACTION = 0.4;
+
+/* ---------------------------------------------------------------------- *
+ * memory usage
+ * ---------------------------------------------------------------------- */
+
+long MemoryUsage::total() const {
+    return graph + codes + parents + indices + queue;
+}
+
+long triangulation_bytes(const Triangulation &triangulation) {
+    long n = triangulation.order();
+    long m = triangulation.size();
+
+    // the vertices and halfedges share one block of the arena, the lists
+    // of pointers are two more allocations
+    return (long) sizeof(Triangulation) + 4 * HEAP_OVERHEAD
+           + n * (long) (sizeof(Vertex) + sizeof(Vertex *))
+           + m * (long) (sizeof(Halfedge) + sizeof(Halfedge *));
+}
+
+void estimate_memory(int n, MemoryUsage &usage) {
+    // a triangulation with a automorphisms has 2m / a rootings and most
+    // triangulations have no automorphisms
+    Triangulation triangulation(n);
+    Code code(triangulation);
+    long m = triangulation.size();
+    double count = rooted_triangulations(n) / (2 * m);
+    double degree = m / 2.0;
+
+    // the map from codes to indices is a hash set of indices that is at
+    // least a quarter full
+    usage.graph = (long) (count * (sizeof(std::vector<int>) + degree * sizeof(int) + HEAP_OVERHEAD));
+    usage.codes = (long) (count * code.length());
+    usage.parents = (long) (count * (sizeof(int) + 2 * sizeof(unsigned short)));
+    usage.indices = (long) (count * 4 * sizeof(int));
+    usage.queue = (long) (FRONTIER_FRACTION * count
+                          * (sizeof(std::pair<Triangulation *, int>) + triangulation_bytes(triangulation)));
+}
+
+long parse_bytes(const char *text) {
+    char *end;
+    double value = std::strtod(text, &end);
+    if (end == text || value < 0) { return -1; }
+    switch (*end) {
+        case '\0': break;
+        case 'K': case 'k': value *= 1024.0; end++; break;
+        case 'M': case 'm': value *= 1024.0 * 1024.0; end++; break;
+        case 'G': case 'g': value *= 1024.0 * 1024.0 * 1024.0; end++; break;
+        default: return -1;
+    }
+    if (*end != '\0') { return -1; }
+    return (long) value;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,115 @@
+/* ---------------------------------------------------------------------- *
+ * memory.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_MEMORY__
+#define __FGG_MEMORY__
+
+#include "triangulation.hpp"
+
+#include <cstddef>
+#include <new>
+
+/* ---------------------------------------------------------------------- *
+ * constants
+ * ---------------------------------------------------------------------- */
+
+// the bookkeeping overhead of every heap allocation in bytes
+const long HEAP_OVERHEAD = 16;
+
+// the fraction of the memory limit at which the exploration degrades
+const double MEMORY_DEGRADE_FRACTION = 0.9;
+
+/* ---------------------------------------------------------------------- *
+ * memory usage
+ * ---------------------------------------------------------------------- */
+
+// the number of bytes used by the data structures of a flip graph
+// computation
+struct MemoryUsage {
+    // the adjacency lists
+    long graph;
+
+    // the stored codes
+    long codes;
+
+    // the parent pointers and flips of the search tree and the numbers of
+    // automorphisms
+    long parents;
+
+    // the map from codes to indices
+    long indices;
+
+    // the queue of the breadth first search and its triangulations
+    long queue;
+
+    // returns the sum of all structures
+    long total() const;
+};
+
+// returns the number of bytes of the specified triangulation
+long triangulation_bytes(const Triangulation &triangulation);
+
+// estimates the memory used by the computation of the flip graph on n
+// vertices from the number of rooted triangulations, the largest possible
+// degree and a frontier of 40% of all triangulations. the codes are
+// accounted in any case, since they are stored during the computation.
+void estimate_memory(int n, MemoryUsage &usage);
+
+// parses a number of bytes with an optional suffix K, M or G (powers of
+// 1024). returns -1 if the text is invalid.
+long parse_bytes(const char *text);
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the counting allocator class
+ *
+ * an allocator that adds the size of all allocations it currently holds
+ * to a counter, which allows to account the memory of containers whose
+ * nodes are allocated internally (e.g., maps and deques).
+ * ---------------------------------------------------------------------- */
+
+template <typename T>
+class CountingAllocator {
+public:
+    typedef T value_type;
+
+    // constructor that counts allocations in the specified counter
+    CountingAllocator(long *bytes) : bytes(bytes) {
+    }
+
+    // constructor that shares the counter of the specified allocator
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> &allocator) : bytes(allocator.bytes) {
+    }
+
+    // the counter of allocated bytes
+    long *bytes;
+
+    // allocates memory for the specified number of objects
+    T *allocate(std::size_t count) {
+        *bytes += (long) (count * sizeof(T)) + HEAP_OVERHEAD;
+        return static_cast<T *>(::operator new(count * sizeof(T)));
+    }
+
+    // frees memory of the specified number of objects
+    void deallocate(T *pointer, std::size_t count) {
+        *bytes -= (long) (count * sizeof(T)) + HEAP_OVERHEAD;
+        ::operator delete(pointer);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U> &allocator) const {
+        return bytes == allocator.bytes;
+    }
+
+    template <typename U>
+    bool operator!=(const CountingAllocator<U> &allocator) const {
+        return bytes != allocator.bytes;
+    }
+};
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,137 @@
+/* ---------------------------------------------------------------------- *
+ * plantri.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "plantri.hpp"
+
+#include <cstring>
+
+/* ---------------------------------------------------------------------- *
+ * constants
+ * ---------------------------------------------------------------------- */
+
+// the header written in front of planar code streams
+const char *PLANAR_CODE_HEADER = ">>planar_code le<<";
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the planar code reader class
+ * ---------------------------------------------------------------------- */
+
+PlanarCodeReader::PlanarCodeReader(std::istream &input_stream)
+        : input_stream_(input_stream), header_read_(false), big_endian_(false), records_(0), failed_(false) {
+}
+
+void PlanarCodeReader::read_header() {
+    header_read_ = true;
+    std::streambuf *buffer = input_stream_.rdbuf();
+    if (buffer->sgetc() != '>') { return; }
+
+    // read header up to the closing "<<"
+    std::string header;
+    int c;
+    while ((c = buffer->sbumpc()) != std::streambuf::traits_type::eof()) {
+        header.push_back((char) c);
+        if (header.size() >= 4 && header.compare(header.size() - 2, 2, "<<") == 0) { break; }
+    }
+    big_endian_ = header.find(" be") != std::string::npos;
+}
+
+int PlanarCodeReader::read_entry(bool wide) {
+    std::streambuf *buffer = input_stream_.rdbuf();
+    int low = buffer->sbumpc();
+    if (low == std::streambuf::traits_type::eof() || !wide) { return low; }
+    int high = buffer->sbumpc();
+    if (high == std::streambuf::traits_type::eof()) { return -1; }
+    return big_endian_ ? (low << 8) | high : (high << 8) | low;
+}
+
+int PlanarCodeReader::read(std::vector<int> &rotation_system) {
+    if (!header_read_) { read_header(); }
+
+    // read number of vertices
+    bool wide = false;
+    int n = read_entry(false);
+    if (n < 0) { return 0; }
+    if (n == 0) {
+        wide = true;
+        n = read_entry(true);
+        if (n <= 0) { return -1; }
+    }
+
+    // read neighbor lists
+    rotation_system.clear();
+    for (int i = 0; i < n; ++i) {
+        int entry;
+        do {
+            entry = read_entry(wide);
+            if (entry < 0 || entry > n) { return -1; }
+            rotation_system.push_back(entry);
+        } while (entry != 0);
+    }
+
+    return n;
+}
+
+Triangulation *PlanarCodeReader::next() {
+    int n = read(rotation_system_);
+    if (n == 0) { return nullptr; }
+    records_++;
+    failed_ = n < 0 || !is_valid_rotation_system(n, rotation_system_);
+    if (failed_) { return nullptr; }
+
+    return new Triangulation(n, rotation_system_);
+}
+
+bool PlanarCodeReader::failed() const {
+    return failed_;
+}
+
+long PlanarCodeReader::records() const {
+    return records_;
+}
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the planar code writer class
+ * ---------------------------------------------------------------------- */
+
+PlanarCodeWriter::PlanarCodeWriter(std::ostream &output_stream)
+        : output_stream_(output_stream), header_written_(false) {
+}
+
+void PlanarCodeWriter::append_entry(int entry, bool wide) {
+    buffer_.push_back((unsigned char) (entry & 0xff));
+    if (wide) { buffer_.push_back((unsigned char) (entry >> 8)); }
+}
+
+void PlanarCodeWriter::write(const Triangulation &triangulation) {
+    if (!header_written_) {
+        output_stream_.write(PLANAR_CODE_HEADER, strlen(PLANAR_CODE_HEADER));
+        header_written_ = true;
+    }
+
+    int n = triangulation.order();
+    bool wide = n > 255;
+    for (int i = 0; i < n; ++i) {
+        triangulation.vertex(i)->set_label(i + 1);
+    }
+
+    buffer_.clear();
+    if (wide) { buffer_.push_back(0); }
+    append_entry(n, wide);
+
+    for (int i = 0; i < n; ++i) {
+        Halfedge *first = triangulation.vertex(i)->halfedge();
+        Halfedge *current = first;
+        do {
+            append_entry(current->target()->label(), wide);
+            current = current->twin()->next();
+        } while (current != first);
+        append_entry(0, wide);
+    }
+
+    output_stream_.write((const char *) buffer_.data(), buffer_.size());
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,109 @@
+/* ---------------------------------------------------------------------- *
+ * plantri.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_PLANTRI__
+#define __FGG_PLANTRI__
+
+#include "triangulation.hpp"
+
+#include <vector>
+#include <iostream>
+
+/* ---------------------------------------------------------------------- *
+ * planar code
+ *
+ * planar code is the binary format used by plantri. a stream may start
+ * with the header ">>planar_code<<" (optionally ">>planar_code le<<" or
+ * ">>planar_code be<<"). every graph consists of its number of vertices n
+ * followed by the neighbors (1 to n) of every vertex in cyclic order, each
+ * list terminated by a zero. all numbers are single bytes, unless the
+ * graph starts with a zero byte. in this case n and all entries are
+ * 16 bit integers of the endianness given in the header.
+ * ---------------------------------------------------------------------- */
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the planar code reader class
+ * ---------------------------------------------------------------------- */
+
+class PlanarCodeReader {
+public:
+    // constructor that reads from the specified stream
+    PlanarCodeReader(std::istream &input_stream);
+
+private:
+    // the underlying stream
+    std::istream &input_stream_;
+
+    // whether the header has already been processed
+    bool header_read_;
+
+    // whether 16 bit entries are stored in big endian order
+    bool big_endian_;
+
+    // the rotation system of the last graph
+    std::vector<int> rotation_system_;
+
+    // the number of graphs read so far
+    long records_;
+
+    // whether the last graph was invalid
+    bool failed_;
+
+    // reads the optional header
+    void read_header();
+
+    // reads a single entry, returns -1 at the end of the stream
+    int read_entry(bool wide);
+
+public:
+    // reads the next graph's rotation system and returns its number of
+    // vertices. returns 0 at the end of the stream and -1 on errors.
+    int read(std::vector<int> &rotation_system);
+
+    // reads the next triangulation, which is either planar or a
+    // triangulated polygon. returns nullptr at the end of the stream or if
+    // the graph is not a valid triangulation, in which case failed returns
+    // true. invalid graphs are rejected before any triangulation is built.
+    Triangulation *next();
+
+    // returns whether the last graph was invalid
+    bool failed() const;
+
+    // returns the number of graphs read so far (including an invalid one)
+    long records() const;
+};
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the planar code writer class
+ * ---------------------------------------------------------------------- */
+
+class PlanarCodeWriter {
+public:
+    // constructor that writes to the specified stream
+    PlanarCodeWriter(std::ostream &output_stream);
+
+private:
+    // the underlying stream
+    std::ostream &output_stream_;
+
+    // whether the header has already been written
+    bool header_written_;
+
+    // the buffer for the current graph
+    std::vector<unsigned char> buffer_;
+
+    // appends the specified entry to the buffer
+    void append_entry(int entry, bool wide);
+
+public:
+    // writes the specified triangulation, where the vertices are numbered
+    // in the order of the triangulation's vertex list
+    void write(const Triangulation &triangulation);
+};
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
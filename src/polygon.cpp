@@ -0,0 +1,157 @@
+/* ---------------------------------------------------------------------- *
+ * polygon.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "polygon.hpp"
+#include "codeindex.hpp"
+
+#include <cassert>
+
+/* ---------------------------------------------------------------------- *
+ * helper functions
+ * ---------------------------------------------------------------------- */
+
+// returns the index of the lowest set bit of the specified nonzero value
+static inline int lowest_bit(uint32_t value) {
+    return __builtin_ctz(value);
+}
+
+// returns the start of the lexicographically least rotation of the
+// specified sequence of n symbols (booth's algorithm, linear time)
+static int least_rotation(const unsigned char *sequence, int n) {
+    unsigned char doubled[2 * MAX_POLYGON_ORDER];
+    int failure[2 * MAX_POLYGON_ORDER];
+    for (int i = 0; i < 2 * n; ++i) {
+        doubled[i] = sequence[i < n ? i : i - n];
+        failure[i] = -1;
+    }
+
+    int k = 0;
+    for (int j = 1; j < 2 * n; ++j) {
+        unsigned char symbol = doubled[j];
+        int i = failure[j - k - 1];
+        while (i != -1 && symbol != doubled[k + i + 1]) {
+            if (symbol < doubled[k + i + 1]) { k = j - i - 1; }
+            i = failure[i];
+        }
+        if (symbol != doubled[k + i + 1]) {
+            // here i is -1
+            if (symbol < doubled[k]) { k = j; }
+            failure[j - k] = -1;
+        } else {
+            failure[j - k] = i + 1;
+        }
+    }
+    return k;
+}
+
+std::size_t PolygonKeyHash::operator()(const PolygonKey &key) const {
+    return (std::size_t) hash_symbols((const unsigned char *) key.words, sizeof(key.words), 0);
+}
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the polygon class
+ * ---------------------------------------------------------------------- */
+
+Polygon::Polygon(int n) : n_(n) {
+    assert(n >= 3 && n <= MAX_POLYGON_ORDER);
+
+    // the sides of the polygon
+    for (int i = 0; i < n; ++i) {
+        neighbors_[i] = (1u << ((i + 1) % n)) | (1u << ((i + n - 1) % n));
+    }
+
+    // the diagonals of the fan at vertex 0
+    for (int i = 2; i < n - 1; ++i) {
+        neighbors_[0] |= 1u << i;
+        neighbors_[i] |= 1u;
+    }
+
+    // every vertex but 0 is in the triangles at its two sides except the
+    // ears 1 and n - 1
+    triangles_[0] = (unsigned char) (n - 2);
+    for (int i = 1; i < n; ++i) { triangles_[i] = 2; }
+    triangles_[1] = 1;
+    triangles_[n - 1] = 1;
+}
+
+int Polygon::order() const {
+    return n_;
+}
+
+bool Polygon::is_diagonal(int a, int c) const {
+    int distance = (c - a + n_) % n_;
+    return distance != 1 && distance != n_ - 1 && (neighbors_[a] >> c & 1u);
+}
+
+void Polygon::diagonals(std::vector<std::pair<int, int> > &diagonals) const {
+    for (int a = 0; a < n_; ++a) {
+        // neighbors greater than a except the next vertex on the polygon
+        uint32_t candidates = neighbors_[a] & ~((2u << (a + 1)) - 1);
+        if (a == 0) { candidates &= ~(1u << (n_ - 1)); }
+        while (candidates) {
+            int c = lowest_bit(candidates);
+            candidates &= candidates - 1;
+            diagonals.push_back(std::make_pair(a, c));
+        }
+    }
+}
+
+std::pair<int, int> Polygon::flip(int a, int c) {
+    assert(is_diagonal(a, c));
+
+    // the apexes of the two triangles at the diagonal
+    uint32_t common = neighbors_[a] & neighbors_[c];
+    int b = lowest_bit(common);
+    int d = lowest_bit(common & (common - 1));
+    assert(__builtin_popcount(common) == 2);
+
+    neighbors_[a] &= ~(1u << c);
+    neighbors_[c] &= ~(1u << a);
+    neighbors_[b] |= 1u << d;
+    neighbors_[d] |= 1u << b;
+    triangles_[a]--;
+    triangles_[c]--;
+    triangles_[b]++;
+    triangles_[d]++;
+    return std::make_pair(b, d);
+}
+
+PolygonKey Polygon::key() const {
+    int start = least_rotation(triangles_, n_);
+
+    // 12 symbols of 5 bits per word
+    PolygonKey key = {{0, 0}};
+    for (int i = 0; i < n_; ++i) {
+        int j = start + i;
+        if (j >= n_) { j -= n_; }
+        key.words[i / 12] |= (uint64_t) triangles_[j] << (5 * (i % 12));
+    }
+    return key;
+}
+
+int Polygon::automorphisms() const {
+    int count = 1;
+    for (int shift = 1; shift < n_; ++shift) {
+        int i = 0;
+        while (i < n_ && triangles_[i] == triangles_[(i + shift) % n_]) { i++; }
+        if (i == n_) { count++; }
+    }
+    return count;
+}
+
+void Polygon::rotation_system(std::vector<int> &rotation_system) const {
+    rotation_system.clear();
+    for (int a = 0; a < n_; ++a) {
+        // the neighbors in the order of their distance along the polygon
+        for (int distance = 1; distance < n_; ++distance) {
+            int c = (a + distance) % n_;
+            if (neighbors_[a] >> c & 1u) { rotation_system.push_back(c + 1); }
+        }
+        rotation_system.push_back(0);
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
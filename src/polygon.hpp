@@ -0,0 +1,105 @@
+/* ---------------------------------------------------------------------- *
+ * polygon.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_POLYGON__
+#define __FGG_POLYGON__
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+/* ---------------------------------------------------------------------- *
+ * constants
+ * ---------------------------------------------------------------------- */
+
+// the maximal number of vertices of a polygon, such that the key of a
+// triangulation fits into 120 bits
+const int MAX_POLYGON_ORDER = 24;
+
+/* ---------------------------------------------------------------------- *
+ * polygon keys
+ *
+ * a triangulated polygon is determined by the number of triangles at each
+ * of its vertices in the order around the polygon (its quiddity sequence).
+ * the key of a triangulated polygon is the lexicographically least
+ * rotation of this sequence packed into 5 bits per vertex, hence two
+ * triangulations have the same key if and only if one is a rotation of
+ * the other (as for the codes of outerplanar triangulations, mirror
+ * images are distinct).
+ * ---------------------------------------------------------------------- */
+
+struct PolygonKey {
+    uint64_t words[2];
+
+    bool operator==(const PolygonKey &other) const {
+        return words[0] == other.words[0] && words[1] == other.words[1];
+    }
+};
+
+// hash function object for polygon keys
+struct PolygonKeyHash {
+    std::size_t operator()(const PolygonKey &key) const;
+};
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the polygon class
+ *
+ * a polygon is a triangulation of a convex polygon whose vertices are
+ * labeled 0 to n - 1 in counterclockwise order. it stores the neighbors
+ * of every vertex as bitset and the number of triangles at every vertex,
+ * such that a flip of a diagonal takes constant time: the two triangles
+ * at the diagonal ac are abc and acd, where b and d are the two common
+ * neighbors of a and c.
+ * ---------------------------------------------------------------------- */
+
+class Polygon {
+public:
+    // constructor that builds the fan of the n-gon at vertex 0, which is
+    // the canonical outerplanar triangulation
+    Polygon(int n);
+
+private:
+    // the number of vertices
+    int n_;
+
+    // the neighbors of every vertex as bitset
+    uint32_t neighbors_[MAX_POLYGON_ORDER];
+
+    // the number of triangles at every vertex
+    unsigned char triangles_[MAX_POLYGON_ORDER];
+
+public:
+    // returns the number of vertices
+    int order() const;
+
+    // returns whether vertex a and vertex c are joined by a diagonal
+    bool is_diagonal(int a, int c) const;
+
+    // appends the diagonals as pairs (a, c) with a < c to the list
+    void diagonals(std::vector<std::pair<int, int> > &diagonals) const;
+
+    // replaces the diagonal ac by the other diagonal bd of the
+    // quadrilateral around it and returns bd (with b < d). flipping bd
+    // afterwards restores the polygon.
+    std::pair<int, int> flip(int a, int c);
+
+    // returns the key of the triangulation
+    PolygonKey key() const;
+
+    // returns the number of automorphisms of the triangulation, i.e., the
+    // number of rotations that leave its quiddity sequence unchanged
+    int automorphisms() const;
+
+    // computes the rotation system in the format of the triangulation
+    // class, i.e., the labels (1 to n) of the neighbors of every vertex in
+    // cyclic order followed by a zero
+    void rotation_system(std::vector<int> &rotation_system) const;
+};
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,175 @@
+/* ---------------------------------------------------------------------- *
+ * profile.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "profile.hpp"
+
+#include <cstring>
+#include <cassert>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * helper functions
+ * ---------------------------------------------------------------------- */
+
+double seconds_since(std::chrono::steady_clock::time_point start_time) {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+    return elapsed.count();
+}
+
+// the names of the hardware counters in the report
+static const char *COUNTER_NAMES[PROFILE_COUNTERS] = {
+    "cycles", "instructions", "cache_misses", "branch_misses"
+};
+
+#ifdef __linux__
+// opens a counter of the specified hardware event for this process and
+// all threads it creates later. returns -1 on failure.
+static int open_counter(uint64_t event) {
+    struct perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = event;
+    attributes.inherit = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    return (int) syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0);
+}
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the profile class
+ * ---------------------------------------------------------------------- */
+
+Profile::Profile(bool hardware_counters) : has_counters_(false) {
+    for (int i = 0; i < PROFILE_COUNTERS; ++i) { counters_[i] = -1; }
+
+#ifdef __linux__
+    if (hardware_counters) {
+        const uint64_t events[PROFILE_COUNTERS] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+        };
+        has_counters_ = true;
+        for (int i = 0; i < PROFILE_COUNTERS; ++i) {
+            counters_[i] = open_counter(events[i]);
+            if (counters_[i] < 0) { has_counters_ = false; }
+        }
+    }
+#endif
+}
+
+Profile::~Profile() {
+    for (int i = 0; i < PROFILE_COUNTERS; ++i) {
+        if (counters_[i] >= 0) { close(counters_[i]); }
+    }
+}
+
+void Profile::read_counters(uint64_t *values) const {
+    for (int i = 0; i < PROFILE_COUNTERS; ++i) {
+        values[i] = 0;
+        if (has_counters_ && read(counters_[i], &values[i], sizeof(uint64_t)) != sizeof(uint64_t)) {
+            values[i] = 0;
+        }
+    }
+}
+
+int Profile::phase(const std::string &name) {
+    int size = (int) phases_.size();
+    for (int i = 0; i < size; ++i) {
+        if (phases_[i].name == name) { return i; }
+    }
+
+    Phase phase;
+    phase.name = name;
+    phase.calls = 0;
+    phase.seconds = 0;
+    phase.running = false;
+    for (int i = 0; i < PROFILE_COUNTERS; ++i) { phase.counters[i] = 0; }
+    phases_.push_back(phase);
+    return size;
+}
+
+void Profile::begin(int phase) {
+    assert(phase >= 0 && phase < (int) phases_.size());
+    Phase &current = phases_[phase];
+    assert(!current.running);
+    current.running = true;
+    current.calls++;
+    read_counters(current.start_counters);
+    current.start_time = std::chrono::steady_clock::now();
+}
+
+void Profile::end(int phase) {
+    assert(phase >= 0 && phase < (int) phases_.size());
+    Phase &current = phases_[phase];
+    if (!current.running) { return; }
+    current.seconds += seconds_since(current.start_time);
+
+    uint64_t values[PROFILE_COUNTERS];
+    read_counters(values);
+    for (int i = 0; i < PROFILE_COUNTERS; ++i) { current.counters[i] += values[i] - current.start_counters[i]; }
+    current.running = false;
+}
+
+void Profile::add(int phase, double seconds, long calls) {
+    assert(phase >= 0 && phase < (int) phases_.size());
+    phases_[phase].seconds += seconds;
+    phases_[phase].calls += calls;
+}
+
+void Profile::set_value(const std::string &name, double value) {
+    for (std::pair<std::string, double> &entry : values_) {
+        if (entry.first == name) {
+            entry.second = value;
+            return;
+        }
+    }
+    values_.push_back(std::make_pair(name, value));
+}
+
+bool Profile::has_counters() const {
+    return has_counters_;
+}
+
+void Profile::write_json(std::ostream &output_stream) const {
+    output_stream << "{\"counters\": " << (has_counters_ ? "true" : "false") << ", \"phases\": [";
+    int size = (int) phases_.size();
+    for (int i = 0; i < size; ++i) {
+        const Phase &phase = phases_[i];
+        output_stream << ((i > 0) ? ",\n  " : "\n  ")
+                      << "{\"name\": \"" << phase.name << "\", \"calls\": " << phase.calls
+                      << ", \"seconds\": " << phase.seconds;
+
+        // phases that are only accumulated have no counter values
+        bool counted = false;
+        for (int j = 0; j < PROFILE_COUNTERS; ++j) { counted = counted || phase.counters[j] > 0; }
+        if (has_counters_ && counted) {
+            for (int j = 0; j < PROFILE_COUNTERS; ++j) {
+                output_stream << ", \"" << COUNTER_NAMES[j] << "\": " << phase.counters[j];
+            }
+        }
+        output_stream << "}";
+    }
+    output_stream << "\n], \"values\": {";
+    for (int i = 0; i < (int) values_.size(); ++i) {
+        output_stream << ((i > 0) ? ", " : "") << "\"" << values_[i].first << "\": ";
+        double value = values_[i].second;
+        if (value == (double) (long) value) {
+            output_stream << (long) value;
+        } else {
+            output_stream << value;
+        }
+    }
+    output_stream << "}}" << std::endl;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
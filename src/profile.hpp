@@ -0,0 +1,112 @@
+/* ---------------------------------------------------------------------- *
+ * profile.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_PROFILE__
+#define __FGG_PROFILE__
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+
+/* ---------------------------------------------------------------------- *
+ * constants
+ * ---------------------------------------------------------------------- */
+
+// the hardware counters: cycles, instructions, cache misses, branch misses
+const int PROFILE_COUNTERS = 4;
+
+// returns the wall time in seconds since the specified point in time
+double seconds_since(std::chrono::steady_clock::time_point start_time);
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the profile class
+ *
+ * a profile records the wall time spent in named phases of a run. phases
+ * are either timed by begin and end, which also reads the hardware
+ * counters of the process if they are enabled, or accumulated by add for
+ * operations that are too short and too frequent to read the counters
+ * (e.g., single flips). phases may be nested and every phase may be
+ * entered several times. the hardware counters are read with
+ * perf_event_open and are only available on linux if the kernel permits
+ * it; otherwise only wall times are recorded. in addition, a profile
+ * holds named values that are reported along with the phases (e.g., the
+ * memory used by data structures).
+ * ---------------------------------------------------------------------- */
+
+class Profile {
+public:
+    // constructor that opens the hardware counters if requested
+    Profile(bool hardware_counters);
+
+    // destructor that closes the hardware counters
+    ~Profile();
+
+private:
+    struct Phase {
+        // the name of the phase
+        std::string name;
+
+        // the number of times the phase was entered
+        long calls;
+
+        // the total wall time in seconds
+        double seconds;
+
+        // the total counter values
+        uint64_t counters[PROFILE_COUNTERS];
+
+        // whether the phase is running and when and at which counter
+        // values it started
+        bool running;
+        std::chrono::steady_clock::time_point start_time;
+        uint64_t start_counters[PROFILE_COUNTERS];
+    };
+
+    // the phases in the order of their creation
+    std::vector<Phase> phases_;
+
+    // the file descriptors of the hardware counters (-1 if not open)
+    int counters_[PROFILE_COUNTERS];
+
+    // whether all hardware counters are open
+    bool has_counters_;
+
+    // the named values in the order of their creation
+    std::vector<std::pair<std::string, double> > values_;
+
+    // reads the current values of the hardware counters
+    void read_counters(uint64_t *values) const;
+
+public:
+    // returns the identifier of the phase with the specified name, which is
+    // created if it does not exist yet
+    int phase(const std::string &name);
+
+    // starts timing the specified phase
+    void begin(int phase);
+
+    // stops timing the specified phase (if it is running)
+    void end(int phase);
+
+    // adds the specified wall time and number of calls to the phase
+    void add(int phase, double seconds, long calls);
+
+    // sets the value with the specified name
+    void set_value(const std::string &name, double value);
+
+    // returns whether the hardware counters are available
+    bool has_counters() const;
+
+    // writes the phases and values as json object
+    void write_json(std::ostream &output_stream) const;
+};
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,67 @@
+/* ---------------------------------------------------------------------- *
+ * progress.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "progress.hpp"
+
+#include <fstream>
+#include <unistd.h>
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the progress class
+ * ---------------------------------------------------------------------- */
+
+Progress::Progress(std::ostream &output_stream, double interval)
+        : output_stream_(output_stream), interval_(interval), calls_(0), last_seconds_(0) {
+    start_time_ = std::chrono::steady_clock::now();
+    next_time_ = start_time_ + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(interval_));
+    last_state_ = ProgressState{0, 0, 0, 0, 0, 0, 0};
+}
+
+bool Progress::check_time() {
+    return std::chrono::steady_clock::now() >= next_time_;
+}
+
+void Progress::report(const ProgressState &state) {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed = now - start_time_;
+    double seconds = elapsed.count();
+    double delta = seconds - last_seconds_;
+
+    // rates since the previous report
+    double codes_rate = (delta > 0) ? (state.codes - last_state_.codes) / delta : 0;
+    double flips_rate = (delta > 0) ? (state.flips - last_state_.flips) / delta : 0;
+
+    output_stream_ << "{\"seconds\": " << seconds
+                   << ", \"layer\": " << state.layer
+                   << ", \"frontier\": " << state.frontier
+                   << ", \"discovered\": " << state.discovered
+                   << ", \"edges\": " << state.edges
+                   << ", \"codes_per_second\": " << codes_rate
+                   << ", \"flips_per_second\": " << flips_rate
+                   << ", \"accounted_bytes\": " << state.accounted
+                   << ", \"resident_bytes\": " << resident_memory() << "}" << std::endl;
+
+    last_seconds_ = seconds;
+    last_state_ = state;
+    next_time_ = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(interval_));
+}
+
+/* ---------------------------------------------------------------------- *
+ * helper functions
+ * ---------------------------------------------------------------------- */
+
+long resident_memory() {
+    // the second field of statm is the number of resident pages
+    std::ifstream statm("/proc/self/statm");
+    long size = 0;
+    long resident = 0;
+    if (!(statm >> size >> resident)) { return 0; }
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,98 @@
+/* ---------------------------------------------------------------------- *
+ * progress.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_PROGRESS__
+#define __FGG_PROGRESS__
+
+#include <iostream>
+#include <chrono>
+
+/* ---------------------------------------------------------------------- *
+ * constants
+ * ---------------------------------------------------------------------- */
+
+// the number of calls of due between two readings of the clock
+const long PROGRESS_CHECK_PERIOD = 64;
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the progress class
+ *
+ * a progress reporter writes the state of a long running exploration
+ * periodically as one json object per line. the exploration calls due
+ * once per expanded triangulation, which only increments a counter and
+ * reads the clock every PROGRESS_CHECK_PERIOD calls, and reports its
+ * state if due returns true. the reporter computes the rates since the
+ * previous report and adds the resident memory of the process.
+ * ---------------------------------------------------------------------- */
+
+// the state of an exploration
+struct ProgressState {
+    // the current layer of the breadth first search
+    int layer;
+
+    // the number of triangulations in the queue
+    long frontier;
+
+    // the number of triangulations discovered so far
+    long discovered;
+
+    // the number of edges found so far
+    long edges;
+
+    // the number of flips performed so far
+    long flips;
+
+    // the number of codes computed so far
+    long codes;
+
+    // the accounted memory of the data structures in bytes
+    long accounted;
+};
+
+class Progress {
+public:
+    // constructor that reports to the specified stream every interval seconds
+    Progress(std::ostream &output_stream, double interval);
+
+private:
+    // the stream the reports are written to
+    std::ostream &output_stream_;
+
+    // the time between two reports in seconds
+    double interval_;
+
+    // the number of calls of due since the last reading of the clock
+    long calls_;
+
+    // the start of the exploration and the time of the next report
+    std::chrono::steady_clock::time_point start_time_;
+    std::chrono::steady_clock::time_point next_time_;
+
+    // the time and state of the previous report
+    double last_seconds_;
+    ProgressState last_state_;
+
+    // reads the clock and returns whether the next report is due
+    bool check_time();
+
+public:
+    // returns whether a report is due
+    bool due() {
+        if (++calls_ < PROGRESS_CHECK_PERIOD) { return false; }
+        calls_ = 0;
+        return check_time();
+    }
+
+    // writes a report of the specified state
+    void report(const ProgressState &state);
+};
+
+// returns the resident memory of this process in bytes or 0 if unknown
+long resident_memory();
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
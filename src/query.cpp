@@ -0,0 +1,227 @@
+/* ---------------------------------------------------------------------- *
+ * query.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "query.hpp"
+#include "codeio.hpp"
+#include "functions.hpp"
+
+#include <cstring>
+#include <cstdlib>
+#include <csignal>
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/* ---------------------------------------------------------------------- *
+ * stream buffer for file descriptors
+ * ---------------------------------------------------------------------- */
+
+class FileDescriptorBuffer : public std::streambuf {
+public:
+    // constructor that reads from and writes to the specified descriptor
+    FileDescriptorBuffer(int file) : file_(file) {
+        setg(input_, input_, input_);
+        setp(output_, output_ + BUFFER_SIZE);
+    }
+
+    // destructor that writes all pending output
+    ~FileDescriptorBuffer() {
+        flush();
+    }
+
+private:
+    static const int BUFFER_SIZE = 1 << 16;
+
+    // the file descriptor
+    int file_;
+
+    // the input buffer
+    char input_[BUFFER_SIZE];
+
+    // the output buffer
+    char output_[BUFFER_SIZE];
+
+    // writes the content of the output buffer, returns -1 on errors
+    int flush() {
+        char *position = pbase();
+        while (position < pptr()) {
+            ssize_t written = ::write(file_, position, pptr() - position);
+            if (written < 0 && errno == EINTR) { continue; }
+            if (written <= 0) { return -1; }
+            position += written;
+        }
+        setp(output_, output_ + BUFFER_SIZE);
+        return 0;
+    }
+
+protected:
+    int_type underflow() {
+        ssize_t count;
+        do {
+            count = ::read(file_, input_, BUFFER_SIZE);
+        } while (count < 0 && errno == EINTR);
+        if (count <= 0) { return traits_type::eof(); }
+        setg(input_, input_, input_ + count);
+        return traits_type::to_int_type(*gptr());
+    }
+
+    int_type overflow(int_type c) {
+        if (flush() < 0) { return traits_type::eof(); }
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int sync() {
+        return flush();
+    }
+
+    std::streamsize showmanyc() {
+        struct pollfd descriptor = {file_, POLLIN, 0};
+        return (poll(&descriptor, 1, 0) > 0) ? 1 : 0;
+    }
+};
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the query server class
+ * ---------------------------------------------------------------------- */
+
+QueryServer::QueryServer(const FlipGraph &flip_graph, const CodeIndex &code_index)
+        : flip_graph_(flip_graph), code_index_(code_index), view_(flip_graph.graph()) {
+    distance_list(view_, std::vector<int>(1, 0), depths_);
+    eccentricities_.resize(flip_graph_.graph().size(), -1);
+}
+
+const char *QueryServer::parse_triangulation(const char *begin, const char *end, int &index) {
+    while (begin != end && *begin == ' ') { begin++; }
+    if (begin == end) { return nullptr; }
+
+    if (*begin == '#') {
+        // index of the triangulation
+        char *position;
+        long value = strtol(begin + 1, &position, 10);
+        if (position == begin + 1) { return nullptr; }
+        int size = (int) flip_graph_.graph().size();
+        index = (value >= 0 && value < size) ? (int) value : -1;
+        return position;
+    }
+
+    // code of the triangulation. the index only contains canonical codes,
+    // so other codes are validated and canonicalized before a second lookup
+    const char *position = parse_code(begin, end, symbols_);
+    if (position == nullptr) { return nullptr; }
+    index = code_index_.lookup(symbols_.data(), (int) symbols_.size());
+    if (index < 0) {
+        Code code(symbols_.data(), (int) symbols_.size());
+        if (!canonicalize_code(code)) { return nullptr; }
+        index = code_index_.lookup(code.symbols(), code.length());
+    }
+    return position;
+}
+
+void QueryServer::answer(const std::string &line, std::ostream &output_stream) {
+    const char *begin = line.c_str();
+    const char *end = begin + line.size();
+    if (end != begin && end[-1] == '\r') { end--; }
+
+    // get command
+    const char *position = begin;
+    while (position != end && *position != ' ') { position++; }
+    std::string command(begin, position);
+
+    // get arguments
+    int arguments = (command == "distance") ? 2 : 1;
+    int indices[2] = {-1, -1};
+    for (int i = 0; i < arguments && position != nullptr; ++i) {
+        position = parse_triangulation(position, end, indices[i]);
+    }
+    if (position != nullptr) {
+        while (position != end && *position == ' ') { position++; }
+    }
+    if (position != end) {
+        output_stream << "error" << '\n';
+        return;
+    }
+
+    int result = -1;
+    if (command == "index") {
+        result = indices[0];
+    } else if (command == "depth") {
+        if (indices[0] >= 0) { result = depths_[indices[0]]; }
+    } else if (command == "eccentricity") {
+        int index = indices[0];
+        if (index >= 0) {
+            if (eccentricities_[index] < 0) {
+                eccentricities_[index] = eccentricity(view_, index);
+            }
+            result = eccentricities_[index];
+        }
+    } else if (command == "distance") {
+        if (indices[0] >= 0 && indices[1] >= 0) {
+            result = bidirectional_distance(view_, indices[0], indices[1]);
+        }
+    } else {
+        output_stream << "error" << '\n';
+        return;
+    }
+
+    output_stream << result << '\n';
+}
+
+void QueryServer::serve(std::istream &input_stream, std::ostream &output_stream) {
+    std::string line;
+    while (std::getline(input_stream, line)) {
+        if (!line.empty() && line != "\r") { answer(line, output_stream); }
+
+        // flush answers if the client waits for them
+        if (input_stream.rdbuf()->in_avail() <= 0) { output_stream.flush(); }
+    }
+    output_stream.flush();
+}
+
+bool QueryServer::serve_socket(const char *path) {
+    struct sockaddr_un address;
+    if (strlen(path) >= sizeof(address.sun_path)) { return false; }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0) { return false; }
+    unlink(path);
+    if (bind(server, (struct sockaddr *) &address, sizeof(address)) != 0 || listen(server, 16) != 0) {
+        close(server);
+        return false;
+    }
+
+    // clients that disconnect early must not terminate the server
+    signal(SIGPIPE, SIG_IGN);
+
+    while (true) {
+        int client = accept(server, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) { continue; }
+            break;
+        }
+
+        FileDescriptorBuffer buffer(client);
+        std::istream input_stream(&buffer);
+        std::ostream output_stream(&buffer);
+        serve(input_stream, output_stream);
+        output_stream.flush();
+        close(client);
+    }
+
+    close(server);
+    unlink(path);
+    return true;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,80 @@
+/* ---------------------------------------------------------------------- *
+ * query.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_QUERY__
+#define __FGG_QUERY__
+
+#include "flipgraph.hpp"
+#include "codeindex.hpp"
+#include "flipview.hpp"
+
+#include <vector>
+#include <string>
+#include <iostream>
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the query server class
+ *
+ * the query server answers questions about triangulations in a flip graph
+ * that has been computed or loaded once. every query is a single line:
+ *
+ *   index <t>             the index of triangulation t
+ *   depth <t>             the distance of t to the canonical triangulation
+ *   eccentricity <t>      the eccentricity of t
+ *   distance <t> <t>      the flip distance between two triangulations
+ *
+ * a triangulation t is given either by its code in text format or by its
+ * index prefixed with '#'. every query is answered by a single line that
+ * contains the result, -1 if a triangulation is not contained in the flip
+ * graph, or "error" if the query is malformed.
+ * ---------------------------------------------------------------------- */
+
+class QueryServer {
+public:
+    // constructor for the specified flip graph and code index
+    QueryServer(const FlipGraph &flip_graph, const CodeIndex &code_index);
+
+private:
+    // the flip graph
+    const FlipGraph &flip_graph_;
+
+    // the index of the flip graph's codes
+    const CodeIndex &code_index_;
+
+    // the flip graph in compressed sparse row format for distance queries
+    ExplicitFlipGraph view_;
+
+    // the distances of all triangulations to the canonical triangulation
+    std::vector<int> depths_;
+
+    // the eccentricities computed so far (-1 if not yet computed)
+    std::vector<int> eccentricities_;
+
+    // buffer for parsed codes
+    std::vector<unsigned char> symbols_;
+
+    // parses a triangulation at the specified position and stores its
+    // index (-1 if unknown). returns the position after the triangulation
+    // or nullptr if the text is malformed.
+    const char *parse_triangulation(const char *begin, const char *end, int &index);
+
+public:
+    // answers the query in the specified line
+    void answer(const std::string &line, std::ostream &output_stream);
+
+    // answers all queries in the input stream. the answers are buffered
+    // and flushed whenever no further input is immediately available.
+    void serve(std::istream &input_stream, std::ostream &output_stream);
+
+    // listens on a unix socket at the specified path and serves all
+    // connections one after another. returns false if the socket cannot
+    // be created.
+    bool serve_socket(const char *path);
+};
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,170 @@
+/* ---------------------------------------------------------------------- *
+ * sampler.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "sampler.hpp"
+#include "codeio.hpp"
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <chrono>
+
+/* ---------------------------------------------------------------------- *
+ * constants
+ * ---------------------------------------------------------------------- */
+
+// the size of the output buffer of each thread
+const std::size_t SAMPLE_BUFFER_SIZE = 1 << 20;
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the flip walker class
+ * ---------------------------------------------------------------------- */
+
+FlipWalker::FlipWalker(int n, uint64_t seed, bool unlabeled)
+        : triangulation_(n), unlabeled_(unlabeled), automorphisms_(1), steps_(0), flips_(0) {
+    // scramble the seed (splitmix64) since xorshift needs a nonzero state
+    // and nearby seeds should yield unrelated walks
+    uint64_t z = seed + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    state_ = (z ^ (z >> 31)) | 1;
+
+    if (unlabeled_) { automorphisms_ = Code::automorphisms(triangulation_); }
+}
+
+int FlipWalker::random_index(int bound) {
+    // xorshift64*
+    state_ ^= state_ >> 12;
+    state_ ^= state_ << 25;
+    state_ ^= state_ >> 27;
+    uint64_t random = (state_ * 0x2545f4914f6cdd1dULL) >> 32;
+    return (int) ((random * (uint64_t) bound) >> 32);
+}
+
+void FlipWalker::walk(long steps) {
+    int m = triangulation_.size();
+    for (long i = 0; i < steps; ++i) {
+        Halfedge *halfedge = triangulation_.halfedge(random_index(m));
+        if (!triangulation_.is_flippable(halfedge)) { continue; }
+        triangulation_.flip_unchecked(halfedge);
+
+        if (unlabeled_) {
+            // metropolis correction: accept with probability min(1, new / old)
+            int automorphisms = Code::automorphisms(triangulation_);
+            if (automorphisms < automorphisms_ && random_index(automorphisms_) >= automorphisms) {
+                triangulation_.flip_unchecked(halfedge);
+                continue;
+            }
+            automorphisms_ = automorphisms;
+        }
+        flips_++;
+    }
+    steps_ += steps;
+}
+
+const Triangulation &FlipWalker::triangulation() const {
+    return triangulation_;
+}
+
+long FlipWalker::steps() const {
+    return steps_;
+}
+
+long FlipWalker::flips() const {
+    return flips_;
+}
+
+/* ---------------------------------------------------------------------- *
+ * sampling
+ * ---------------------------------------------------------------------- */
+
+// appends the specified triangulation in the specified format to the buffer
+static void append_sample(const Triangulation &triangulation, int format, std::string &buffer) {
+    if (format == SAMPLE_FORMAT_DEGREES) {
+        int n = triangulation.order();
+        std::vector<int> degrees(n);
+        for (int i = 0; i < n; ++i) { degrees[i] = triangulation.vertex(i)->degree(); }
+        std::sort(degrees.begin(), degrees.end());
+        for (int i = 0; i < n; ++i) {
+            if (i > 0) { buffer += ' '; }
+            buffer += std::to_string(degrees[i]);
+        }
+        buffer += '\n';
+    } else if (format == SAMPLE_FORMAT_CODE) {
+        std::ostringstream stream;
+        Code(triangulation).write_to_stream(stream);
+        buffer += stream.str();
+    } else {
+        Code code(triangulation);
+        buffer.append((const char *) code.symbols(), code.length());
+    }
+}
+
+// writes the buffer to the stream
+static void flush_samples(std::string &buffer, std::ostream *output_stream, std::mutex *mutex) {
+    std::lock_guard<std::mutex> lock(*mutex);
+    output_stream->write(buffer.data(), buffer.size());
+    buffer.clear();
+}
+
+// runs every threads-th walker starting with the specified one
+static void run_walkers(const SamplerSettings *settings, int first, std::ostream *output_stream,
+                        std::mutex *mutex, SamplerStatistics *statistics) {
+    std::string buffer;
+    for (int i = first; i < settings->walkers; i += settings->threads) {
+        FlipWalker walker(settings->n, settings->seed + i, settings->unlabeled);
+        walker.walk(settings->burn_in);
+        for (long j = 0; j < settings->samples; ++j) {
+            if (j > 0) { walker.walk(settings->spacing); }
+            append_sample(walker.triangulation(), settings->format, buffer);
+            if (buffer.size() >= SAMPLE_BUFFER_SIZE) { flush_samples(buffer, output_stream, mutex); }
+        }
+        statistics->steps += walker.steps();
+        statistics->flips += walker.flips();
+    }
+    flush_samples(buffer, output_stream, mutex);
+}
+
+void sample_triangulations(const SamplerSettings &settings, std::ostream &output_stream,
+                           SamplerStatistics &statistics) {
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+    if (settings.format == SAMPLE_FORMAT_BINARY) {
+        Triangulation triangulation(settings.n);
+        int length = settings.n + triangulation.size() + 1;
+        uint64_t count = (uint64_t) settings.walkers * settings.samples;
+        write_code_file_header(output_stream, settings.n, length, count);
+    }
+
+    // run walkers
+    int threads = std::max(1, std::min(settings.threads, settings.walkers));
+    SamplerSettings thread_settings = settings;
+    thread_settings.threads = threads;
+    std::vector<SamplerStatistics> thread_statistics(threads);
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    for (int i = 0; i < threads; ++i) {
+        thread_statistics[i].steps = 0;
+        thread_statistics[i].flips = 0;
+        workers.push_back(std::thread(run_walkers, &thread_settings, i, &output_stream, &mutex,
+                                      &thread_statistics[i]));
+    }
+    for (std::thread &worker : workers) { worker.join(); }
+
+    statistics.steps = 0;
+    statistics.flips = 0;
+    for (const SamplerStatistics &thread_statistic : thread_statistics) {
+        statistics.steps += thread_statistic.steps;
+        statistics.flips += thread_statistic.flips;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+    statistics.seconds = elapsed.count();
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
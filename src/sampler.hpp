@@ -0,0 +1,135 @@
+/* ---------------------------------------------------------------------- *
+ * sampler.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_SAMPLER__
+#define __FGG_SAMPLER__
+
+#include "triangulation.hpp"
+
+#include <iostream>
+#include <cstdint>
+
+/* ---------------------------------------------------------------------- *
+ * constants
+ * ---------------------------------------------------------------------- */
+
+// samples are written as sorted degree sequences, one per line
+const int SAMPLE_FORMAT_DEGREES = 0;
+
+// samples are written as codes in text format
+const int SAMPLE_FORMAT_CODE = 1;
+
+// samples are written as a binary code file
+const int SAMPLE_FORMAT_BINARY = 2;
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the flip walker class
+ *
+ * a flip walker performs a random walk on the flip graph. in every step a
+ * halfedge is chosen uniformly at random and flipped if it is flippable,
+ * otherwise the walker stays put. the transition matrix is symmetric,
+ * hence the walk converges to the uniform distribution on labeled
+ * triangulations. with the metropolis correction a flip to a triangulation
+ * with fewer automorphisms is only accepted with probability equal to the
+ * ratio of the automorphism counts, which yields the uniform distribution
+ * on unlabeled triangulations (at the cost of computing the automorphisms
+ * after every flip, which limits it to 127 vertices).
+ * ---------------------------------------------------------------------- */
+
+class FlipWalker {
+public:
+    // constructor that starts at the canonical triangulation on n vertices
+    FlipWalker(int n, uint64_t seed, bool unlabeled);
+
+private:
+    // the current triangulation
+    Triangulation triangulation_;
+
+    // the state of the random number generator
+    uint64_t state_;
+
+    // whether the metropolis correction is applied
+    bool unlabeled_;
+
+    // the number of automorphisms of the current triangulation
+    int automorphisms_;
+
+    // the number of steps performed so far
+    long steps_;
+
+    // the number of flips performed so far
+    long flips_;
+
+    // returns a random number in [0, bound)
+    int random_index(int bound);
+
+public:
+    // performs the specified number of steps
+    void walk(long steps);
+
+    // returns the current triangulation
+    const Triangulation &triangulation() const;
+
+    // returns the number of steps performed so far
+    long steps() const;
+
+    // returns the number of flips performed so far
+    long flips() const;
+};
+
+/* ---------------------------------------------------------------------- *
+ * sampling
+ * ---------------------------------------------------------------------- */
+
+struct SamplerSettings {
+    // the number of vertices
+    int n;
+
+    // the number of independent walkers
+    int walkers;
+
+    // the number of threads the walkers are distributed to
+    int threads;
+
+    // the number of steps before the first sample of a walker
+    long burn_in;
+
+    // the number of steps between two samples of a walker
+    long spacing;
+
+    // the number of samples per walker
+    long samples;
+
+    // whether the samples are uniform on unlabeled triangulations
+    bool unlabeled;
+
+    // the seed of the first walker (the i-th walker uses seed + i)
+    uint64_t seed;
+
+    // the output format (SAMPLE_FORMAT_DEGREES, _CODE or _BINARY)
+    int format;
+};
+
+struct SamplerStatistics {
+    // the number of steps of all walkers
+    long steps;
+
+    // the number of flips of all walkers
+    long flips;
+
+    // the elapsed wall clock time in seconds
+    double seconds;
+};
+
+// runs the walkers of the specified settings and writes their samples to
+// the stream. the samples of each walker are written in order, but the
+// samples of different walkers may be interleaved.
+void sample_triangulations(const SamplerSettings &settings, std::ostream &output_stream,
+                           SamplerStatistics &statistics);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
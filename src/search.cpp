@@ -0,0 +1,343 @@
+/* ---------------------------------------------------------------------- *
+ * search.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "search.hpp"
+#include "codeindex.hpp"
+#include "codeio.hpp"
+#include "flipview.hpp"
+#include "profile.hpp"
+
+#include <unordered_map>
+#include <algorithm>
+#include <utility>
+#include <queue>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+
+/* ---------------------------------------------------------------------- *
+ * constants
+ * ---------------------------------------------------------------------- */
+
+// the maximal number of entries in the transposition table of ida*
+const std::size_t TRANSPOSITION_TABLE_SIZE = 1 << 22;
+
+/* ---------------------------------------------------------------------- *
+ * heuristic search
+ * ---------------------------------------------------------------------- */
+
+// a node of the a* search
+struct SearchNode {
+    // the code of the triangulation
+    const Code *code;
+
+    // the distance from the source
+    int distance;
+
+    // the index of the node the triangulation was discovered from
+    int parent;
+};
+
+// the lower bound of flip_distance_lower_bound, which is updated with the
+// four degrees that change by a flip instead of being recomputed
+class DegreeBound {
+public:
+    // constructor that stores the sorted degree sequence of the target
+    DegreeBound(const std::vector<int> &degrees);
+
+private:
+    // the sorted degree sequence of the target triangulation
+    const std::vector<int> &degrees_;
+
+    // the sorted degree sequence of the current triangulation
+    std::vector<int> sequence_;
+
+    // the l1 distance between the two sequences
+    int difference_;
+
+    // changes one degree of the current triangulation by the specified
+    // amount, which keeps the sequence sorted if the first (for a
+    // decrease) or the last (for an increase) occurrence is changed
+    void change(int degree, int amount);
+
+public:
+    // sets the current triangulation
+    void assign(const Triangulation &triangulation);
+
+    // updates the current degrees for a flip of the specified halfedge,
+    // which must be called before the flip (also before the flip that
+    // undoes an earlier one)
+    void flip(Halfedge *halfedge);
+
+    // returns the lower bound of the current triangulation
+    int bound() const;
+};
+
+// the state of an ida* search
+struct IterativeSearch {
+    // the code of the target triangulation
+    const Code *target;
+
+    // the lower bound of the current triangulation
+    DegreeBound *bound;
+
+    // the smallest distance at which a triangulation has been reached
+    // during the current iteration
+    std::unordered_map<Code, int, CodeHash> table;
+
+    // the codes of the current flip sequence
+    std::vector<Code> path;
+
+    // the number of expanded triangulations
+    long expanded;
+};
+
+// computes the sorted degree sequence of the specified triangulation
+static void degree_sequence(const Triangulation &triangulation, std::vector<int> &degrees) {
+    int n = triangulation.order();
+    degrees.resize(n);
+    for (int i = 0; i < n; ++i) { degrees[i] = triangulation.vertex(i)->degree(); }
+    std::sort(degrees.begin(), degrees.end());
+}
+
+DegreeBound::DegreeBound(const std::vector<int> &degrees) : degrees_(degrees), difference_(0) {}
+
+void DegreeBound::change(int degree, int amount) {
+    int i;
+    if (amount < 0) {
+        i = (int) (std::lower_bound(sequence_.begin(), sequence_.end(), degree) - sequence_.begin());
+    } else {
+        i = (int) (std::upper_bound(sequence_.begin(), sequence_.end(), degree) - sequence_.begin()) - 1;
+    }
+    difference_ -= std::abs(sequence_[i] - degrees_[i]);
+    sequence_[i] += amount;
+    difference_ += std::abs(sequence_[i] - degrees_[i]);
+}
+
+void DegreeBound::assign(const Triangulation &triangulation) {
+    degree_sequence(triangulation, sequence_);
+    difference_ = 0;
+    int n = (int) sequence_.size();
+    for (int i = 0; i < n; ++i) { difference_ += std::abs(sequence_[i] - degrees_[i]); }
+}
+
+void DegreeBound::flip(Halfedge *halfedge) {
+    // the endpoints lose the edge and the opposite vertices gain it
+    change(halfedge->target()->degree(), -1);
+    change(halfedge->twin()->target()->degree(), -1);
+    change(halfedge->next()->target()->degree(), 1);
+    change(halfedge->twin()->next()->target()->degree(), 1);
+}
+
+int DegreeBound::bound() const {
+    return (difference_ + 3) / 4;
+}
+
+// performs a depth first search from the last triangulation of the path
+// that only follows flip sequences whose estimated length does not exceed
+// the threshold. returns -1 if the target is found and the smallest
+// estimate exceeding the threshold otherwise.
+static int iterative_search(IterativeSearch &search, Triangulation &triangulation,
+                            int distance, int threshold) {
+    int estimate = distance + search.bound->bound();
+    if (estimate > threshold) { return estimate; }
+    if (search.path.back() == *search.target) { return -1; }
+
+    search.expanded++;
+    int minimum = INT_MAX;
+    int m = triangulation.size();
+    for (int i = 0; i < m; ++i) {
+        Halfedge *halfedge = triangulation.halfedge(i);
+        if (!triangulation.is_representative(halfedge) || !triangulation.is_flippable(halfedge)) { continue; }
+
+        search.bound->flip(halfedge);
+        triangulation.flip(halfedge);
+        Code code(triangulation);
+
+        // skip triangulations that have already been reached on a
+        // flip sequence that is not longer
+        std::unordered_map<Code, int, CodeHash>::iterator it = search.table.find(code);
+        bool known = it != search.table.end();
+        if (!known || it->second > distance + 1) {
+            if (known) {
+                it->second = distance + 1;
+            } else if (search.table.size() < TRANSPOSITION_TABLE_SIZE) {
+                search.table[code] = distance + 1;
+            }
+
+            search.path.push_back(code);
+            int result = iterative_search(search, triangulation, distance + 1, threshold);
+            if (result == -1) { return -1; }
+            minimum = std::min(minimum, result);
+            search.path.pop_back();
+        }
+
+        search.bound->flip(halfedge);
+        triangulation.flip(halfedge);
+    }
+
+    return minimum;
+}
+
+int flip_distance_lower_bound(const Triangulation &triangulation, const std::vector<int> &degrees) {
+    DegreeBound bound(degrees);
+    bound.assign(triangulation);
+    return bound.bound();
+}
+
+int flip_distance_astar(const Code &source_code, const Code &target_code, std::vector<Code> &path,
+                        SearchStatistics &statistics) {
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+    statistics.expanded = 0;
+    statistics.seconds = 0;
+    path.clear();
+    if (source_code.length() != target_code.length() || source_code.symbol(0) != target_code.symbol(0)) {
+        return -1;
+    }
+
+    // the triangulations are identified by their canonical codes
+    Code source = source_code;
+    Code target = target_code;
+    if (!canonicalize_code(source) || !canonicalize_code(target)) { return -1; }
+    std::vector<int> degrees;
+    Triangulation triangulation(target);
+    degree_sequence(triangulation, degrees);
+    DegreeBound bound(degrees);
+
+    // open list ordered by estimate and, for equal estimates, by decreasing distance
+    typedef std::pair<int, std::pair<int, int> > Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > open;
+    std::unordered_map<Code, int, CodeHash> indices;
+    std::vector<SearchNode> nodes;
+
+    triangulation.assign(source);
+    bound.assign(triangulation);
+    SearchNode root = {&indices.insert(std::make_pair(source, 0)).first->first, 0, -1};
+    nodes.push_back(root);
+    open.push(std::make_pair(bound.bound(), std::make_pair(0, 0)));
+
+    // the triangulation that is expanded and the code of its neighbors are
+    // reused, such that only new triangulations allocate a code
+    Code code = source;
+    int found = -1;
+    while (!open.empty()) {
+        int index = open.top().second.second;
+        int distance = -open.top().second.first;
+        open.pop();
+
+        // skip outdated entries
+        if (distance > nodes[index].distance) { continue; }
+
+        if (*nodes[index].code == target) {
+            found = index;
+            break;
+        }
+
+        // expand triangulation
+        statistics.expanded++;
+        triangulation.assign(*nodes[index].code);
+        bound.assign(triangulation);
+        int m = triangulation.size();
+        for (int i = 0; i < m; ++i) {
+            Halfedge *halfedge = triangulation.halfedge(i);
+            if (!triangulation.is_representative(halfedge) || !triangulation.is_flippable(halfedge)) { continue; }
+
+            bound.flip(halfedge);
+            triangulation.flip(halfedge);
+            code.assign(triangulation);
+            std::unordered_map<Code, int, CodeHash>::iterator it = indices.find(code);
+            int other = -1;
+            if (it == indices.end()) {
+                other = (int) nodes.size();
+                SearchNode node = {&indices.insert(std::make_pair(code, other)).first->first, distance + 1, index};
+                nodes.push_back(node);
+            } else if (nodes[it->second].distance > distance + 1) {
+                other = it->second;
+                nodes[other].distance = distance + 1;
+                nodes[other].parent = index;
+            }
+            if (other >= 0) {
+                int estimate = distance + 1 + bound.bound();
+                open.push(std::make_pair(estimate, std::make_pair(-(distance + 1), other)));
+            }
+            bound.flip(halfedge);
+            triangulation.flip(halfedge);
+        }
+    }
+
+    statistics.seconds = seconds_since(start_time);
+    if (found < 0) { return -1; }
+
+    for (int index = found; index >= 0; index = nodes[index].parent) {
+        path.push_back(*nodes[index].code);
+    }
+    std::reverse(path.begin(), path.end());
+    return (int) path.size() - 1;
+}
+
+int flip_distance_idastar(const Code &source_code, const Code &target_code, std::vector<Code> &path,
+                          SearchStatistics &statistics) {
+    std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+    statistics.expanded = 0;
+    statistics.seconds = 0;
+    path.clear();
+    if (source_code.length() != target_code.length() || source_code.symbol(0) != target_code.symbol(0)) {
+        return -1;
+    }
+
+    // the triangulations are identified by their canonical codes
+    Code source = source_code;
+    Code target = target_code;
+    if (!canonicalize_code(source) || !canonicalize_code(target)) { return -1; }
+    std::vector<int> degrees;
+    Triangulation triangulation(target);
+    degree_sequence(triangulation, degrees);
+    DegreeBound bound(degrees);
+    IterativeSearch search;
+    search.target = &target;
+    search.bound = &bound;
+    search.expanded = 0;
+
+    // increase threshold until the target is found
+    triangulation.assign(source);
+    bound.assign(triangulation);
+    int threshold = bound.bound();
+    int result = threshold;
+    while (result >= 0 && result < INT_MAX) {
+        threshold = result;
+        search.table.clear();
+        search.table[source] = 0;
+        search.path.assign(1, source);
+        result = iterative_search(search, triangulation, 0, threshold);
+    }
+
+    statistics.expanded = search.expanded;
+    statistics.seconds = seconds_since(start_time);
+    if (result != -1) { return -1; }
+
+    path.swap(search.path);
+    return (int) path.size() - 1;
+}
+
+/* ---------------------------------------------------------------------- *
+ * search functions
+ * ---------------------------------------------------------------------- */
+
+int flip_distance(const Code &source_code, const Code &target_code, std::vector<Code> &path, int threads) {
+    path.clear();
+    if (source_code.length() != target_code.length() || source_code.symbol(0) != target_code.symbol(0)) {
+        return -1;
+    }
+
+    // the triangulations are identified by their canonical codes
+    Code source = source_code;
+    Code target = target_code;
+    if (!canonicalize_code(source) || !canonicalize_code(target)) { return -1; }
+    ImplicitFlipGraph view;
+    return bidirectional_distance(view, source, target, &path, threads);
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,59 @@
+/* ---------------------------------------------------------------------- *
+ * search.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_SEARCH__
+#define __FGG_SEARCH__
+
+#include "triangulation.hpp"
+
+#include <vector>
+
+/* ---------------------------------------------------------------------- *
+ * search statistics
+ * ---------------------------------------------------------------------- */
+
+struct SearchStatistics {
+    // the number of expanded triangulations
+    long expanded;
+
+    // the elapsed wall clock time in seconds
+    double seconds;
+};
+
+/* ---------------------------------------------------------------------- *
+ * search functions
+ * ---------------------------------------------------------------------- */
+
+// computes the flip distance between the triangulations with the specified
+// codes using a bidirectional breadth first search on the implicit flip
+// graph. the codes need not be canonical. the canonical codes of a shortest
+// flip sequence from source to target (including both) are stored in path.
+// the neighbors of each layer are computed by the specified number of threads.
+int flip_distance(const Code &source, const Code &target, std::vector<Code> &path, int threads = 1);
+
+// computes a lower bound on the flip distance between the specified
+// triangulation and a triangulation with the specified sorted degree
+// sequence. a flip changes four degrees by one, hence the bound is a
+// quarter of the l1 distance between the sorted degree sequences.
+int flip_distance_lower_bound(const Triangulation &triangulation, const std::vector<int> &degrees);
+
+// computes the flip distance between the triangulations with the specified
+// codes using an a* search guided by flip_distance_lower_bound. the codes
+// need not be canonical. the canonical codes of a shortest flip sequence
+// are stored in path.
+int flip_distance_astar(const Code &source, const Code &target, std::vector<Code> &path,
+                        SearchStatistics &statistics);
+
+// computes the flip distance between the triangulations with the specified
+// codes using an iterative deepening a* search, which only stores the
+// current flip sequence and a transposition table. the codes need not be
+// canonical.
+int flip_distance_idastar(const Code &source, const Code &target, std::vector<Code> &path,
+                          SearchStatistics &statistics);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -0,0 +1,185 @@
+/* ---------------------------------------------------------------------- *
+ * spectral.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "spectral.hpp"
+
+#include <cmath>
+#include <thread>
+#include <algorithm>
+#include <cassert>
+
+/* ---------------------------------------------------------------------- *
+ * constants
+ * ---------------------------------------------------------------------- */
+
+// the minimal number of rows per thread of a matrix vector product
+const int MINIMUM_ROWS_PER_THREAD = 4096;
+
+// the number of bisection steps per eigenvalue of the tridiagonal matrix
+const int BISECTION_STEPS = 100;
+
+/* ---------------------------------------------------------------------- *
+ * implementation of the sparse graph class
+ * ---------------------------------------------------------------------- */
+
+SparseGraph::SparseGraph(const Graph &graph) {
+    int size = (int) graph.size();
+    offsets_.resize(size + 1);
+    scales_.resize(size);
+    offsets_[0] = 0;
+    for (int i = 0; i < size; ++i) {
+        int degree = (int) graph[i].size();
+        offsets_[i + 1] = offsets_[i] + degree;
+        scales_[i] = (degree > 0) ? 1 / std::sqrt((double) degree) : 0;
+    }
+    targets_.reserve(offsets_[size]);
+    for (int i = 0; i < size; ++i) {
+        targets_.insert(targets_.end(), graph[i].begin(), graph[i].end());
+    }
+}
+
+int SparseGraph::size() const {
+    return (int) scales_.size();
+}
+
+// computes rows [begin, end) of the product of the adjacency matrix and
+// the scaled vector
+static void multiply_rows(const int *offsets, const int *targets, const double *scales,
+                          const double *scaled, double *y, int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        double sum = 0;
+        for (int j = offsets[i]; j < offsets[i + 1]; ++j) { sum += scaled[targets[j]]; }
+        y[i] = scales[i] * sum;
+    }
+}
+
+void SparseGraph::multiply(const std::vector<double> &x, std::vector<double> &y, int threads) const {
+    int size = this->size();
+    y.resize(size);
+
+    // scale the input once so that the inner loop only sums neighbors
+    std::vector<double> scaled(size);
+    for (int i = 0; i < size; ++i) { scaled[i] = scales_[i] * x[i]; }
+
+    threads = std::max(1, std::min(threads, size / MINIMUM_ROWS_PER_THREAD));
+    if (threads == 1) {
+        multiply_rows(offsets_.data(), targets_.data(), scales_.data(), scaled.data(), y.data(), 0, size);
+        return;
+    }
+
+    // split rows into chunks with about the same number of entries
+    std::vector<std::thread> workers;
+    long entries = offsets_[size];
+    int begin = 0;
+    for (int t = 1; t <= threads; ++t) {
+        int target = (int) (entries * t / threads);
+        int end = (t == threads) ? size
+                  : (int) (std::lower_bound(offsets_.begin(), offsets_.end(), target) - offsets_.begin());
+        end = std::max(begin, std::min(end, size));
+        workers.push_back(std::thread(multiply_rows, offsets_.data(), targets_.data(), scales_.data(),
+                                      scaled.data(), y.data(), begin, end));
+        begin = end;
+    }
+    for (std::thread &worker : workers) { worker.join(); }
+}
+
+const std::vector<double> &SparseGraph::scales() const {
+    return scales_;
+}
+
+/* ---------------------------------------------------------------------- *
+ * helper functions
+ * ---------------------------------------------------------------------- */
+
+static double dot(const std::vector<double> &x, const std::vector<double> &y) {
+    double sum = 0;
+    int size = (int) x.size();
+    for (int i = 0; i < size; ++i) { sum += x[i] * y[i]; }
+    return sum;
+}
+
+// computes y = y - factor * x
+static void subtract(std::vector<double> &y, double factor, const std::vector<double> &x) {
+    int size = (int) x.size();
+    for (int i = 0; i < size; ++i) { y[i] -= factor * x[i]; }
+}
+
+// returns the number of eigenvalues of the symmetric tridiagonal matrix with
+// the specified diagonal and off-diagonal that are smaller than the value
+static int count_smaller(const std::vector<double> &diagonal, const std::vector<double> &off_diagonal,
+                         double value) {
+    int count = 0;
+    double d = 1;
+    int size = (int) diagonal.size();
+    for (int i = 0; i < size; ++i) {
+        double b = (i > 0) ? off_diagonal[i - 1] : 0;
+        d = diagonal[i] - value - ((i > 0) ? b * b / d : 0);
+        if (d == 0) { d = 1e-300; }
+        if (d < 0) { count++; }
+    }
+    return count;
+}
+
+/* ---------------------------------------------------------------------- *
+ * eigenvalues
+ * ---------------------------------------------------------------------- */
+
+void top_eigenvalues(const Graph &graph, int count, int iterations, bool lazy, int threads,
+                     std::vector<double> &eigenvalues) {
+    SparseGraph sparse_graph(graph);
+    int size = sparse_graph.size();
+    iterations = std::min(iterations, size);
+    eigenvalues.clear();
+    if (size == 0) { return; }
+
+    // start vector with a deterministic pseudo random pattern
+    std::vector<std::vector<double> > basis;
+    std::vector<double> q(size);
+    for (int i = 0; i < size; ++i) { q[i] = 1 + 0.5 * std::sin(1.0 + 12.9898 * i); }
+    double norm = std::sqrt(dot(q, q));
+    for (double &value : q) { value /= norm; }
+
+    // lanczos iteration with full reorthogonalization
+    std::vector<double> diagonal;
+    std::vector<double> off_diagonal;
+    std::vector<double> w;
+    for (int j = 0; j < iterations; ++j) {
+        basis.push_back(q);
+        sparse_graph.multiply(q, w, threads);
+        double alpha = dot(w, q);
+        diagonal.push_back(alpha);
+        subtract(w, alpha, q);
+        if (j > 0) { subtract(w, off_diagonal.back(), basis[j - 1]); }
+        for (int k = 0; k <= j; ++k) { subtract(w, dot(w, basis[k]), basis[k]); }
+
+        double beta = std::sqrt(dot(w, w));
+        if (beta < 1e-10 || j + 1 == iterations) { break; }
+        off_diagonal.push_back(beta);
+        for (int i = 0; i < size; ++i) { q[i] = w[i] / beta; }
+    }
+
+    // compute the largest eigenvalues of the tridiagonal matrix by bisection.
+    // the eigenvalues of the normalized adjacency matrix lie in [-1, 1].
+    int dimension = (int) diagonal.size();
+    count = std::min(count, dimension);
+    for (int k = 0; k < count; ++k) {
+        // the (k + 1)-th largest eigenvalue has dimension - k - 1 smaller ones
+        double lower = -1.5;
+        double upper = 1.5;
+        for (int step = 0; step < BISECTION_STEPS; ++step) {
+            double middle = (lower + upper) / 2;
+            if (count_smaller(diagonal, off_diagonal, middle) <= dimension - k - 1) {
+                lower = middle;
+            } else {
+                upper = middle;
+            }
+        }
+        double eigenvalue = (lower + upper) / 2;
+        eigenvalues.push_back(lazy ? (1 + eigenvalue) / 2 : eigenvalue);
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
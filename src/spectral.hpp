@@ -0,0 +1,63 @@
+/* ---------------------------------------------------------------------- *
+ * spectral.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_SPECTRAL__
+#define __FGG_SPECTRAL__
+
+#include <vector>
+
+typedef std::vector<std::vector<int> > Graph;
+
+/* ---------------------------------------------------------------------- *
+ * declaration of the sparse graph class
+ *
+ * a graph in compressed sparse row format: the neighbors of vertex i are
+ * targets[offsets[i]] to targets[offsets[i + 1] - 1].
+ * ---------------------------------------------------------------------- */
+
+class SparseGraph {
+public:
+    // constructor that converts the specified adjacency lists
+    SparseGraph(const Graph &graph);
+
+private:
+    // the start of each vertex's neighbors in targets (size + 1 entries)
+    std::vector<int> offsets_;
+
+    // the neighbors of all vertices
+    std::vector<int> targets_;
+
+    // the inverse square roots of the degrees
+    std::vector<double> scales_;
+
+public:
+    // returns the number of vertices
+    int size() const;
+
+    // computes y = D^-1/2 A D^-1/2 x for the adjacency matrix A and the
+    // degree matrix D using the specified number of threads
+    void multiply(const std::vector<double> &x, std::vector<double> &y, int threads) const;
+
+    // returns the inverse square roots of the degrees
+    const std::vector<double> &scales() const;
+};
+
+/* ---------------------------------------------------------------------- *
+ * eigenvalues
+ * ---------------------------------------------------------------------- */
+
+// computes the largest eigenvalues of the normalized adjacency matrix
+// D^-1/2 A D^-1/2 of the specified graph, which are the eigenvalues of the
+// random walk matrix D^-1 A, in decreasing order using the lanczos method
+// with full reorthogonalization and the specified number of iterations.
+// if lazy is true, the eigenvalues of the lazy random walk (I + D^-1 A) / 2
+// are computed instead.
+void top_eigenvalues(const Graph &graph, int count, int iterations, bool lazy, int threads,
+                     std::vector<double> &eigenvalues);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
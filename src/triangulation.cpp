@@ -2,15 +2,125 @@
  * triangulation.cpp
  * ---------------------------------------------------------------------- */
 
-//#define OUTERPLANAR
 //#define NDEBUG
 
 #include "triangulation.hpp"
 
 #include <queue>
 #include <map>
+#include <new>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <cstring>
 #include <cassert>
 
+// vertices and halfedges live in the arena of their triangulation, which
+// never destroys them
+static_assert(std::is_trivially_destructible<Vertex>::value, "vertices must be trivially destructible");
+static_assert(std::is_trivially_destructible<Halfedge>::value, "halfedges must be trivially destructible");
+
+/* ---------------------------------------------------------------------- *
+ * classes of triangulations
+ * ---------------------------------------------------------------------- */
+
+int triangulation_class(int n, int m) {
+    // both classes coincide for a single triangle
+    return (m == 4 * n - 6 && n > 3) ? CLASS_OUTERPLANAR : CLASS_PLANAR;
+}
+
+int canonical_type(int triangulation_class) {
+    return (triangulation_class == CLASS_OUTERPLANAR) ? TRIANGULATION_OUTERPLANAR : TRIANGULATION_CANONICAL;
+}
+
+bool is_valid_rotation_system(int n, const std::vector<int> &rotation_system) {
+    int size = (int) rotation_system.size();
+    if (n < 4) { return false; }
+
+    // find the lists and the vertex of every entry
+    std::vector<int> starts(n + 1);
+    std::vector<int> sources(size, -1);
+    int index = 0;
+    for (int i = 0; i < n; ++i) {
+        starts[i] = index;
+        while (index < size && rotation_system[index] != 0) { sources[index++] = i; }
+        if (index == size || index - starts[i] < 2) { return false; }
+        index++;
+    }
+    starts[n] = index;
+    int m = size - n;
+    if (index != size || (m != 6 * n - 12 && m != 4 * n - 6)) { return false; }
+
+    // every neighbor is another vertex and occurs once
+    std::vector<std::pair<std::pair<int, int>, int> > halfedges;
+    halfedges.reserve(m);
+    for (int i = 0; i < size; ++i) {
+        if (sources[i] < 0) { continue; }
+        int j = rotation_system[i] - 1;
+        if (j < 0 || j >= n || j == sources[i]) { return false; }
+        halfedges.push_back(std::make_pair(std::make_pair(sources[i], j), i));
+    }
+    std::sort(halfedges.begin(), halfedges.end());
+    for (int i = 1; i < m; ++i) {
+        if (halfedges[i].first == halfedges[i - 1].first) { return false; }
+    }
+
+    // every edge occurs in both lists, its twin is the entry of the
+    // reversed edge
+    std::vector<int> twins(size, -1);
+    for (int i = 0; i < m; ++i) {
+        std::pair<int, int> reversed(halfedges[i].first.second, halfedges[i].first.first);
+        std::vector<std::pair<std::pair<int, int>, int> >::const_iterator it =
+            std::lower_bound(halfedges.begin(), halfedges.end(), std::make_pair(reversed, 0));
+        if (it == halfedges.end() || it->first != reversed) { return false; }
+        twins[halfedges[i].second] = it->second;
+    }
+
+    // the graph is connected
+    std::vector<bool> reached(n, false);
+    std::vector<int> stack(1, 0);
+    reached[0] = true;
+    int count = 1;
+    while (!stack.empty()) {
+        int i = stack.back();
+        stack.pop_back();
+        for (int j = starts[i]; rotation_system[j] != 0; ++j) {
+            int k = rotation_system[j] - 1;
+            if (!reached[k]) {
+                reached[k] = true;
+                stack.push_back(k);
+                count++;
+            }
+        }
+    }
+    if (count != n) { return false; }
+
+    // walk around all faces. the halfedge after the halfedge from b to a is
+    // the one from a to the neighbor following b in the list of a.
+    std::vector<bool> visited(size, false);
+    int outer_faces = 0;
+    for (int i = 0; i < size; ++i) {
+        if (sources[i] < 0 || visited[i]) { continue; }
+        int length = 0;
+        int current = i;
+        do {
+            visited[current] = true;
+            length++;
+            int next = twins[current] + 1;
+            if (rotation_system[next] == 0) { next = starts[sources[next - 1]]; }
+            current = next;
+        } while (current != i && length <= n);
+
+        if (length == n && m == 4 * n - 6) {
+            outer_faces++;
+        } else if (length != 3) {
+            return false;
+        }
+    }
+
+    return outer_faces == ((m == 4 * n - 6) ? 1 : 0);
+}
+
 /* ---------------------------------------------------------------------- *
  * implementation of the vertex class
  * ---------------------------------------------------------------------- */
@@ -33,7 +143,7 @@ void Vertex::increase_degree() {
 
 void Vertex::decrease_degree() {
     degree_--;
-}x
+}
 
 int Vertex::label() const {
     return label_;
@@ -51,7 +161,7 @@ int Vertex::degree() const {
  * implementation of the halfedge class
  * ---------------------------------------------------------------------- */
 
-Halfedge::Halfedge(int id) : id_(id) {
+Halfedge::Halfedge(int id, int index) : id_(id), index_(index) {
     target_ = nullptr;
 }
 
@@ -79,6 +189,10 @@ int Halfedge::id() const {
     return id_;
 }
 
+int Halfedge::index() const {
+    return index_;
+}
+
 Vertex *Halfedge::target() const {
     return target_;
 }
@@ -100,9 +214,6 @@ Halfedge *Halfedge::next() const {
  * ---------------------------------------------------------------------- */
 
 Triangulation::Triangulation(int n, int triangulation_type) {
-#ifdef OUTERPLANAR
-    build_outerplanar(n);
-#else
     switch (triangulation_type) {
         case TRIANGULATION_CANONICAL:
             build_canonical(n);
@@ -113,16 +224,22 @@ Triangulation::Triangulation(int n, int triangulation_type) {
         case TRIANGULATION_DOMINANT_BINARY_TREE:
             build_dominant_binary_tree(n);
             break;
+        case TRIANGULATION_OUTERPLANAR:
+            build_outerplanar(n);
+            break;
         default:
             build_canonical(n);
     }
-#endif
 }
 
 Triangulation::Triangulation(const Code &code) {
     build_from_code(code);
 }
 
+Triangulation::Triangulation(int n, const std::vector<int> &rotation_system) {
+    build_from_rotation_system(n, rotation_system);
+}
+
 Triangulation::Triangulation(const Triangulation &triangulation) {
     copy(triangulation);
 }
@@ -131,15 +248,26 @@ Triangulation::~Triangulation() {
     clear();
 }
 
+void Triangulation::assign(const Code &code) {
+    clear();
+    build_from_code(code);
+}
+
+void Triangulation::reserve(int n, int m) {
+    arena_.reserve(n * sizeof(Vertex) + m * sizeof(Halfedge));
+    vertices_.reserve(n);
+    halfedges_.reserve(m);
+}
+
 Vertex *Triangulation::new_vertex() {
-    Vertex *vertex = new Vertex();
+    Vertex *vertex = new (arena_.allocate(sizeof(Vertex), alignof(Vertex))) Vertex();
     vertices_.push_back(vertex);
     return vertex;
 }
 
 Halfedge *Triangulation::new_edge() {
     int id = halfedges_.size();
-    Halfedge *halfedge = new Halfedge(id);
+    Halfedge *halfedge = new (arena_.allocate(sizeof(Halfedge), alignof(Halfedge))) Halfedge(id, id);
     halfedges_.push_back(halfedge);
     return halfedge;
 }
@@ -262,6 +390,7 @@ void Triangulation::build_first_triangle() {
 
 void Triangulation::build_canonical(int n) {
     assert(n >= 4);
+    reserve(n, 6 * n - 12);
 
     // create first triangle
     build_first_triangle();
@@ -279,6 +408,7 @@ void Triangulation::build_canonical(int n) {
 
 void Triangulation::build_dominant_zig_zag(int n) {
     assert(n >= 4);
+    reserve(n, 6 * n - 12);
 
     // create first triangle
     build_first_triangle();
@@ -301,6 +431,7 @@ void Triangulation::build_dominant_zig_zag(int n) {
 
 void Triangulation::build_dominant_binary_tree(int n) {
     assert(n >= 4);
+    reserve(n, 6 * n - 12);
 
     // create first triangle
     build_first_triangle();
@@ -330,6 +461,7 @@ void Triangulation::build_dominant_binary_tree(int n) {
 
 void Triangulation::build_outerplanar(int n) {
     assert(n >= 4);
+    reserve(n, 6 * n - 12);
 
     // create first triangle
     build_first_triangle();
@@ -347,11 +479,22 @@ void Triangulation::build_outerplanar(int n) {
 #endif
 }
 
+void Triangulation::build_from_code(const Code &code) {
+    int n = (int) code.symbol(0);
+    if (::triangulation_class(n, code.length() - n - 1) == CLASS_OUTERPLANAR) {
+        build_from_code<OuterplanarClass>(code);
+    } else {
+        build_from_code<PlanarClass>(code);
+    }
+}
+
+template <class TriangulationClass>
 void Triangulation::build_from_code(const Code &code) {
     assert(vertices_.empty());
     assert(halfedges_.empty());
 
     int n = (int) code.symbol(0);
+    reserve(n, 6 * n - 12);
 
     for (int i = 0; i < n; ++i) { new_vertex(); }
 
@@ -395,14 +538,75 @@ void Triangulation::build_from_code(const Code &code) {
         vertex_a->set_halfedge(first);
     }
 
-#ifdef OUTERPLANAR
-    // make edges that are adjacent to a non-triangle fixed
-    for (Halfedge *halfedge : halfedges_) {
-        if (halfedge->next()->next()->next() != halfedge) {
-            make_fixed(halfedge);
+    if (TriangulationClass::OUTER_FACE) {
+        // make edges that are adjacent to a non-triangle fixed
+        for (Halfedge *halfedge : halfedges_) {
+            if (halfedge->next()->next()->next() != halfedge) {
+                make_fixed(halfedge);
+            }
         }
     }
+
+#ifndef NDEBUG
+    check(*this);
 #endif
+}
+
+void Triangulation::build_from_rotation_system(int n, const std::vector<int> &rotation_system) {
+    assert(vertices_.empty());
+    assert(halfedges_.empty());
+    reserve(n, 6 * n - 12);
+
+    for (int i = 0; i < n; ++i) { new_vertex(); }
+
+    int index = 0;
+
+    for (int i = 0; i < n; ++i) {
+        Vertex *vertex_a = vertex(i);
+        vertex_a->set_label(i + 1);
+        vertex_a->set_degree(0);
+
+        // connect vertex with its incident edges
+        Halfedge *first = nullptr;
+        Halfedge *last = nullptr;
+        while (rotation_system[index]) {
+            int j = rotation_system[index++] - 1;
+            assert(j >= 0 && j < n && j != i);
+            Vertex *vertex_b = vertex(j);
+            vertex_a->increase_degree();
+
+            Halfedge *current;
+            if (i < j) {
+                // create new halfedge
+                current = new_edge();
+                current->set_target(vertex_b);
+                make_twins(current, new_edge());
+                current->twin()->set_target(vertex_a);
+            } else {
+                // get existing halfedge
+                current = halfedge(vertex_b, vertex_a);
+                assert(current != nullptr);
+                current = current->twin();
+            }
+
+            if (first == nullptr) { first = current; }
+            if (last != nullptr) { make_consecutive(last, current); }
+            last = current->twin();
+        }
+        index++;
+
+        make_consecutive(last, first);
+        vertex_a->set_halfedge(first);
+    }
+
+    if (triangulation_class() == CLASS_OUTERPLANAR) {
+        // make edges that are adjacent to the outer face fixed
+        for (Halfedge *halfedge : halfedges_) {
+            if (halfedge->next()->next()->next() != halfedge) {
+                make_fixed(halfedge);
+            }
+        }
+    }
 
 #ifndef NDEBUG
     check(*this);
@@ -415,41 +619,41 @@ void Triangulation::copy(const Triangulation &triangulation) {
 
     int n = triangulation.order();
     int m = triangulation.size();
-    std::map<Vertex *, Vertex *> vertex_map;
-    std::map<Halfedge *, Halfedge *> edge_map;
+    reserve(n, m);
 
     // create vertices
     for (int i = 0; i < n; ++i) {
-        Vertex *vertex = triangulation.vertex(i);
-        Vertex *copy = new_vertex();
-        vertex_map[vertex] = copy;
+        new_vertex();
     }
 
     // create edges
     for (int i = 0; i < m; ++i) {
-        Halfedge *halfedge = triangulation.halfedge(i);
         Halfedge *copy = new_edge();
-        copy->set_id(halfedge->id());
-        edge_map[halfedge] = copy;
+        copy->set_id(triangulation.halfedge(i)->id());
+    }
+
+    // set members of edges except the targets
+    for (int i = 0; i < m; ++i) {
+        Halfedge *halfedge = triangulation.halfedge(i);
+        Halfedge *copy = halfedges_[i];
+        copy->set_twin(halfedges_[halfedge->twin()->index()]);
+        copy->set_prev(halfedges_[halfedge->prev()->index()]);
+        copy->set_next(halfedges_[halfedge->next()->index()]);
     }
 
-    // set members of vertices
+    // set members of vertices and the targets of their incoming halfedges
     for (int i = 0; i < n; ++i) {
         Vertex *vertex = triangulation.vertex(i);
-        Vertex *copy = vertex_map[vertex];
+        Vertex *copy = vertices_[i];
         copy->set_label(vertex->label());
-        copy->set_halfedge(edge_map[vertex->halfedge()]);
+        copy->set_halfedge(halfedges_[vertex->halfedge()->index()]);
         copy->set_degree(vertex->degree());
-    }
 
-    // set members of edges
-    for (int i = 0; i < m; ++i) {
-        Halfedge *halfedge = triangulation.halfedge(i);
-        Halfedge *copy = edge_map[halfedge];
-        copy->set_target(vertex_map[halfedge->target()]);
-        copy->set_twin(edge_map[halfedge->twin()]);
-        copy->set_prev(edge_map[halfedge->prev()]);
-        copy->set_next(edge_map[halfedge->next()]);
+        Halfedge *halfedge = copy->halfedge();
+        do {
+            halfedge->twin()->set_target(copy);
+            halfedge = halfedge->twin()->next();
+        } while (halfedge != copy->halfedge());
     }
 
 #ifndef NDEBUG
@@ -458,12 +662,9 @@ void Triangulation::copy(const Triangulation &triangulation) {
 }
 
 void Triangulation::clear() {
-    int n = (int) vertices_.size();;
-    int m = (int) halfedges_.size();
-    for (int i = 0; i < n; ++i) { delete vertices_[i]; }
-    for (int j = 0; j < m; ++j) { delete halfedges_[j]; }
     halfedges_.clear();
     vertices_.clear();
+    arena_.release();
 }
 
 int Triangulation::order() const {
@@ -474,6 +675,10 @@ int Triangulation::size() const {
     return (int) halfedges_.size();
 }
 
+int Triangulation::triangulation_class() const {
+    return ::triangulation_class(order(), size());
+}
+
 int Triangulation::min_degree() const {
     int minimum = order();
     for (Vertex *vertex : vertices_) {
@@ -534,6 +739,14 @@ bool Triangulation::is_flippable(Halfedge *halfedge) const {
 void Triangulation::flip(Halfedge *halfedge) {
     assert(is_flippable(halfedge));
 
+    flip_unchecked(halfedge);
+
+#ifndef NDEBUG
+    check(*this);
+#endif
+}
+
+void Triangulation::flip_unchecked(Halfedge *halfedge) {
     Halfedge *twin = halfedge->twin();
     Vertex *vertex_t = halfedge->target();
     Vertex *vertex_s = twin->target();
@@ -557,10 +770,6 @@ void Triangulation::flip(Halfedge *halfedge) {
     vertex_s->decrease_degree();
     vertex_a->increase_degree();
     vertex_b->increase_degree();
-
-#ifndef NDEBUG
-    check(*this);
-#endif
 }
 
 void Triangulation::write_to_stream(std::ostream &output_stream) const {
@@ -595,60 +804,20 @@ void Triangulation::write_to_stream(std::ostream &output_stream) const {
     output_stream << "}" << std::endl;
 }
 
-#ifndef OUTERPLANAR
-
 void Triangulation::check(Triangulation &triangulation) {
-    int n = triangulation.order();
-    int m = triangulation.size();
-
-    assert(m == 2 * (3 * n - 6));
-
-    for (int i = 0; i < n; ++i) {
-        // check vertex pointers
-        Vertex *vertex = triangulation.vertex(i);
-        assert(vertex == vertex->halfedge()->twin()->target());
-
-        // check vertex degree
-        int degree = 0;
-        Halfedge *first = vertex->halfedge();
-        Halfedge *current = first;
-        do {
-            degree++;
-            current = current->twin()->next();
-        } while (current != first);
-        assert(vertex->degree() == degree);
+    if (triangulation.triangulation_class() == CLASS_OUTERPLANAR) {
+        check<OuterplanarClass>(triangulation);
+    } else {
+        check<PlanarClass>(triangulation);
     }
-
-    for (int i = 0; i < m; ++i) {
-        // check halfedge pointers
-        Halfedge *halfedge = triangulation.halfedge(i);
-        assert(halfedge == halfedge->twin()->twin());
-        assert(halfedge->target() == halfedge->next()->twin()->target());
-        assert(halfedge == halfedge->prev()->next());
-        assert(halfedge == halfedge->next()->prev());
-        assert(halfedge == halfedge->next()->next()->next());
-        assert(halfedge == halfedge->prev()->prev()->prev());
-        assert(halfedge->next() == halfedge->prev()->prev());
-        assert(halfedge->prev() == halfedge->next()->next());
-    }
-
-    // handshaking lemma
-    int sum = 0;
-    for (int i = 0; i < n; ++i) {
-        Vertex *vertex = triangulation.vertex(i);
-        int degree = vertex->degree();
-        assert(degree >= 3);
-        sum += degree;
-    }
-    assert(sum == m);
 }
 
-#else
-
+template <class TriangulationClass>
 void Triangulation::check(Triangulation &triangulation) {
     int n = triangulation.order();
     int m = triangulation.size();
 
+    if (!TriangulationClass::OUTER_FACE) { assert(m == 2 * (3 * n - 6)); }
 
     for (int i = 0; i < n; ++i) {
         // check vertex pointers
@@ -666,7 +835,6 @@ void Triangulation::check(Triangulation &triangulation) {
         assert(vertex->degree() == degree);
     }
 
-    bool outer_cycle = false;
     for (int i = 0; i < m; ++i) {
         // check halfedge pointers
         Halfedge *halfedge = triangulation.halfedge(i);
@@ -675,15 +843,16 @@ void Triangulation::check(Triangulation &triangulation) {
         assert(halfedge->target() == halfedge->next()->twin()->target());
         assert(halfedge == halfedge->prev()->next());
         assert(halfedge == halfedge->next()->prev());
-        if (outer_cycle || halfedge == halfedge->next()->next()->next()) {
+        if (!TriangulationClass::OUTER_FACE || halfedge == halfedge->next()->next()->next()) {
             assert(halfedge == halfedge->next()->next()->next());
             assert(halfedge == halfedge->prev()->prev()->prev());
             assert(halfedge->next() == halfedge->prev()->prev());
             assert(halfedge->prev() == halfedge->next()->next());
         } else {
+            // the outer face is bounded by all vertices
             Halfedge *forward = halfedge;
             Halfedge *backward = halfedge;
-            for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
                 forward = forward->next();
                 backward = backward->prev();
             }
@@ -697,13 +866,12 @@ void Triangulation::check(Triangulation &triangulation) {
     for (int i = 0; i < n; ++i) {
         Vertex *vertex = triangulation.vertex(i);
         int degree = vertex->degree();
+        if (!TriangulationClass::OUTER_FACE) { assert(degree >= 3); }
         sum += degree;
     }
     assert(sum == m);
 }
 
-#endif
-
 /* ---------------------------------------------------------------------- *
  * impementation of the code class
  * ---------------------------------------------------------------------- */
@@ -716,6 +884,17 @@ Code::Code(const Triangulation &triangulation, Halfedge *halfedge) {
     compute_code(triangulation, halfedge);
 }
 
+Code::Code(const Triangulation &triangulation, int &automorphisms) {
+    automorphisms = compute_code(triangulation);
+}
+
+Code::Code(const Triangulation &triangulation, Symmetry &symmetry) {
+    std::vector<int> labelings;
+    initialize(triangulation);
+    symmetry.automorphisms = minimize(triangulation, &labelings);
+    compute_orbits(triangulation, labelings, symmetry.orbits);
+}
+
 Code::Code(const Code &code) {
     length_ = code.length_;
     code_ = new unsigned char[length_];
@@ -728,20 +907,56 @@ Code::Code(const std::vector<unsigned char> &code) {
     for (int i = 0; i < length_; ++i) { set_symbol(i, code[i]); }
 }
 
+Code::Code(const unsigned char *symbols, int length) {
+    length_ = length;
+    code_ = new unsigned char[length_];
+    for (int i = 0; i < length_; ++i) { set_symbol(i, symbols[i]); }
+}
+
+Code::Code(const CodeView &code) {
+    length_ = code.length();
+    code_ = new unsigned char[length_];
+    memcpy(code_, code.symbols(), length_);
+}
+
 Code::~Code() {
     delete[] code_;
 }
 
+Code &Code::operator=(const Code &code) {
+    if (this != &code) {
+        if (length_ != code.length_) {
+            delete[] code_;
+            length_ = code.length_;
+            code_ = new unsigned char[length_];
+        }
+        for (int i = 0; i < length_; ++i) { set_symbol(i, code.symbol(i)); }
+    }
+    return *this;
+}
+
+int Code::assign(const Triangulation &triangulation) {
+    int length = triangulation.order() + triangulation.size() + 1;
+    if (length != length_) {
+        delete[] code_;
+        length_ = length;
+        code_ = new unsigned char[length_];
+    }
+    return minimize(triangulation, nullptr);
+}
+
 void Code::initialize(const Triangulation &triangulation) {
     int n = triangulation.order();
     int m = triangulation.size();
+    // the symbols and the sentinel 2n must fit into a byte
+    assert(2 * n <= 255);
     length_ = n + m + 1;
     code_ = new unsigned char[length_];
     code_[0] = n;
     for (int i = 1; i < length_; ++i) { code_[i] = 2 * n; }
 }
 
-void Code::update(const Triangulation &triangulation, Halfedge *halfedge, bool clockwise) {
+int Code::update(const Triangulation &triangulation, Halfedge *halfedge, bool clockwise) {
     int n = triangulation.order();
     for (int i = 0; i < n; ++i) {
         Vertex *vertex = triangulation.vertex(i);
@@ -777,7 +992,7 @@ void Code::update(const Triangulation &triangulation, Halfedge *halfedge, bool c
                 smaller = true;
                 code_[index] = symbol;
             } else if (symbol > code_[index]) {
-                return;
+                return 1;
             }
 
             index++;
@@ -788,29 +1003,108 @@ void Code::update(const Triangulation &triangulation, Halfedge *halfedge, bool c
         if (code_[index] > 0) { smaller = true; }
         code_[index++] = 0;
     }
+    return smaller ? -1 : 0;
 }
 
-void Code::compute_code(const Triangulation &triangulation) {
+int Code::compute_code(const Triangulation &triangulation) {
     initialize(triangulation);
+    return minimize(triangulation, nullptr);
+}
+
+int Code::minimize(const Triangulation &triangulation, std::vector<int> *labelings) {
+    if (triangulation.triangulation_class() == CLASS_OUTERPLANAR) {
+        return minimize<OuterplanarClass>(triangulation, labelings);
+    }
+    return minimize<PlanarClass>(triangulation, labelings);
+}
+
+// appends the labels of all vertices to the specified list
+static void append_labels(const Triangulation &triangulation, std::vector<int> &labelings) {
+    int n = triangulation.order();
+    for (int i = 0; i < n; ++i) { labelings.push_back(triangulation.vertex(i)->label()); }
+}
+
+template <class TriangulationClass>
+int Code::minimize(const Triangulation &triangulation, std::vector<int> *labelings) {
     int m = triangulation.size();
 
-    // compute minimal degree
+    // reset symbols
     int n = triangulation.order();
+    code_[0] = n;
+    for (int i = 1; i < length_; ++i) { code_[i] = 2 * n; }
+
+    // compute minimal degree
     int min_degree = n;
     for (int i = 0; i < n; ++i) {
         Vertex *vertex = triangulation.vertex(i);
         min_degree = std::min(min_degree, vertex->degree());
     }
 
+    // every start that ties with the minimal code corresponds to an
+    // automorphism, a smaller code resets the count
+    int count = 0;
     for (int i = 0; i < m; ++i) {
         Halfedge *halfedge = triangulation.halfedge(i);
         // only compute codes if target vertex has minimal degree
         if (halfedge->target()->degree() > min_degree) { continue; }
-        update(triangulation, halfedge, true);
-#ifndef OUTERPLANAR
-        update(triangulation, halfedge, false);
-#endif
+        for (int orientation = 0; orientation < (TriangulationClass::REFLECTIONS ? 2 : 1); ++orientation) {
+            int comparison = update(triangulation, halfedge, orientation == 0);
+            if (comparison > 0) { continue; }
+            if (comparison < 0) {
+                count = 0;
+                if (labelings != nullptr) { labelings->clear(); }
+            }
+            count++;
+            if (labelings != nullptr) { append_labels(triangulation, *labelings); }
+        }
     }
+    return count;
+}
+
+void Code::compute_orbits(const Triangulation &triangulation, const std::vector<int> &labelings,
+                          std::vector<int> &orbits) {
+    int n = triangulation.order();
+    int m = triangulation.size();
+    int count = (int) labelings.size() / n;
+    assert(count >= 1 && (int) labelings.size() == count * n);
+
+    // the labels are no longer needed, hence they now hold vertex indices
+    for (int i = 0; i < n; ++i) { triangulation.vertex(i)->set_label(i); }
+
+    // every halfedge starts in the orbit of its twin
+    orbits.resize(m);
+    for (int i = 0; i < m; ++i) {
+        orbits[i] = std::min(i, triangulation.halfedge(i)->twin()->index());
+    }
+
+    // the k-th automorphism maps the vertex with some label in the first
+    // labeling to the vertex with the same label in the k-th labeling
+    std::vector<int> vertices(n + 1);
+    std::vector<int> image(n);
+    for (int k = 1; k < count; ++k) {
+        for (int i = 0; i < n; ++i) { vertices[labelings[k * n + i]] = i; }
+        for (int i = 0; i < n; ++i) { image[i] = vertices[labelings[i]]; }
+
+        // join the orbits of every halfedge and its image
+        for (int i = 0; i < m; ++i) {
+            Halfedge *halfedge = triangulation.halfedge(i);
+            Vertex *source = triangulation.vertex(image[halfedge->twin()->target()->label()]);
+            Vertex *target = triangulation.vertex(image[halfedge->target()->label()]);
+            int j = triangulation.halfedge(source, target)->index();
+            int a = i;
+            int b = j;
+            while (orbits[a] != a) { a = orbits[a]; }
+            while (orbits[b] != b) { b = orbits[b]; }
+            if (a < b) {
+                orbits[b] = a;
+            } else {
+                orbits[a] = b;
+            }
+        }
+    }
+
+    // every halfedge points to the smallest index of its orbit
+    for (int i = 0; i < m; ++i) { orbits[i] = orbits[orbits[i]]; }
 }
 
 void Code::compute_code(const Triangulation &triangulation, Halfedge *halfedge) {
@@ -822,6 +1116,12 @@ void Code::compute_code(const Triangulation &triangulation, Halfedge *halfedge)
     update(triangulation, twin, false);
 }
 
+int Code::automorphisms(const Triangulation &triangulation) {
+    int count;
+    Code code(triangulation, count);
+    return count;
+}
+
 void Code::set_symbol(int i, unsigned char symbol) {
     code_[i] = symbol;
 }
@@ -830,6 +1130,10 @@ unsigned char Code::symbol(int i) const {
     return code_[i];
 }
 
+const unsigned char *Code::symbols() const {
+    return code_;
+}
+
 int Code::length() const {
     return length_;
 }
@@ -890,6 +1194,39 @@ void Code::write_to_stream(std::ostream &output_stream) const {
     output_stream << std::endl;
 }
 
+/* ---------------------------------------------------------------------- *
+ * implementation of the code view class
+ * ---------------------------------------------------------------------- */
+
+CodeView::CodeView(const unsigned char *symbols, int length) : symbols_(symbols), length_(length) {}
+
+CodeView::CodeView(const Code &code) : symbols_(code.symbols()), length_(code.length()) {}
+
+unsigned char CodeView::symbol(int i) const {
+    return symbols_[i];
+}
+
+const unsigned char *CodeView::symbols() const {
+    return symbols_;
+}
+
+int CodeView::length() const {
+    return length_;
+}
+
+bool CodeView::operator==(const CodeView &other) const {
+    return length_ == other.length_ && memcmp(symbols_, other.symbols_, length_) == 0;
+}
+
+bool CodeView::operator!=(const CodeView &other) const {
+    return !(*this == other);
+}
+
+bool CodeView::operator<(const CodeView &other) const {
+    if (length_ != other.length_) { return length_ < other.length_; }
+    return memcmp(symbols_, other.symbols_, length_) < 0;
+}
+
 /* ---------------------------------------------------------------------- *
  * end of file
  * ---------------------------------------------------------------------- */
\ No newline at end of file
@@ -5,6 +5,8 @@
 #ifndef __FGG_TRIANGULATION__
 #define __FGG_TRIANGULATION__
 
+#include "arena.hpp"
+
 #include <vector>
 #include <iostream>
 
@@ -15,6 +17,53 @@
 const int TRIANGULATION_CANONICAL = 1;
 const int TRIANGULATION_DOMINANT_ZIG_ZAG = 2;
 const int TRIANGULATION_DOMINANT_BINARY_TREE = 3;
+const int TRIANGULATION_OUTERPLANAR = 4;
+
+const int CLASS_PLANAR = 0;
+const int CLASS_OUTERPLANAR = 1;
+
+/* ---------------------------------------------------------------------- *
+ * classes of triangulations
+ *
+ * a triangulation is either a triangulation of the sphere (planar) with
+ * 6n - 12 halfedges or a triangulated polygon (outerplanar) with 4n - 6
+ * halfedges, whose outer face is bounded by all vertices and whose outer
+ * edges are fixed. the class thus follows from the numbers of vertices and
+ * halfedges and is not stored. the functions that differ between the
+ * classes are templates with one of the policies below as parameter. they
+ * determine the class once per call and then run the specialized version,
+ * which has no branches on the class in its inner loops.
+ * ---------------------------------------------------------------------- */
+
+struct PlanarClass {
+    // whether codes are minimized over both orientations
+    static const bool REFLECTIONS = true;
+
+    // whether one face is not a triangle
+    static const bool OUTER_FACE = false;
+};
+
+struct OuterplanarClass {
+    // whether codes are minimized over both orientations
+    static const bool REFLECTIONS = false;
+
+    // whether one face is not a triangle
+    static const bool OUTER_FACE = true;
+};
+
+// returns the class of triangulations with n vertices and m halfedges
+int triangulation_class(int n, int m);
+
+// returns the type of the canonical triangulation of the specified class
+int canonical_type(int triangulation_class);
+
+// returns whether the specified rotation system (in the format of the
+// rotation system constructor of the triangulation class) describes a
+// triangulation of either class on n vertices: all neighbors are other
+// vertices, every edge occurs in the lists of both of its vertices, the
+// graph is connected and all faces are triangles except for the outer
+// face of a triangulated polygon, which is bounded by all vertices
+bool is_valid_rotation_system(int n, const std::vector<int> &rotation_system);
 
 /* ---------------------------------------------------------------------- *
  * forward declarations
@@ -28,6 +77,10 @@ class Triangulation;
 
 class Code;
 
+class CodeView;
+
+struct Symmetry;
+
 /* ---------------------------------------------------------------------- *
  * declaration of the vertex class
  * ---------------------------------------------------------------------- */
@@ -74,13 +127,16 @@ public:
 
 class Halfedge {
 public:
-    // constructor that creates a halfedge with the specified id
-    Halfedge(int id);
+    // constructor that creates a halfedge with the specified id and index
+    Halfedge(int id, int index);
 
 private:
     // the id
     int id_;
 
+    // the index in the triangulation's list of halfedges
+    int index_;
+
     // the target vertex
     Vertex *target_;
 
@@ -112,6 +168,9 @@ public:
     // returns the id
     int id() const;
 
+    // returns the index in the triangulation's list of halfedges
+    int index() const;
+
     // returns the target vertex
     Vertex *target() const;
 
@@ -145,12 +204,20 @@ public:
     // constructor that builds a triangulation from the specified code
     Triangulation(const Code &code);
 
+    // constructor that builds a triangulation with n vertices from the
+    // specified rotation system. for each vertex, the list contains the
+    // labels (1 to n) of its neighbors in cyclic order followed by a zero.
+    Triangulation(int n, const std::vector<int> &rotation_system);
+
     // constructor that copies the specified triangulation
     Triangulation(const Triangulation &triangulation);
 
     // destructor
     ~Triangulation();
 
+    // replaces this triangulation by the triangulation with the specified code
+    void assign(const Code &code);
+
 protected:
     // the list of vertices
     VertexList vertices_;
@@ -158,6 +225,12 @@ protected:
     // the list of edges
     EdgeList halfedges_;
 
+    // the memory of all vertices and halfedges
+    Arena arena_;
+
+    // reserves memory for n vertices and m halfedges
+    void reserve(int n, int m);
+
     // creates and returns a new vertex
     Vertex *new_vertex();
 
@@ -206,6 +279,13 @@ protected:
     // builds a triangulation form the specified code
     void build_from_code(const Code &code);
 
+    // builds a triangulation of the specified class from the specified code
+    template <class TriangulationClass>
+    void build_from_code(const Code &code);
+
+    // builds a triangulation with n vertices from the specified rotation system
+    void build_from_rotation_system(int n, const std::vector<int> &rotation_system);
+
     // builds a copy of the specified triangulation
     void copy(const Triangulation &triangulation);
 
@@ -219,6 +299,9 @@ public:
     // returns the number of edges
     int size() const;
 
+    // returns the class of the triangulation
+    int triangulation_class() const;
+
     // returns the minimal degree among all vertices
     int min_degree() const;
 
@@ -246,12 +329,41 @@ public:
     // flips the specified halfedge
     void flip(Halfedge *halfedge);
 
+    // flips the specified flippable halfedge without the consistency check
+    // that flip performs in debug builds (for long random walks)
+    void flip_unchecked(Halfedge *halfedge);
+
     // writes the triangualtion to the specified stream
     void write_to_stream(std::ostream &output_stream) const;
 
 protected:
     // debug
     void check(Triangulation &triangulation);
+
+    // checks a triangulation of the specified class
+    template <class TriangulationClass>
+    void check(Triangulation &triangulation);
+};
+
+/* ---------------------------------------------------------------------- *
+ * symmetries of a triangulation
+ *
+ * the code of a triangulation is the minimum over all starting halfedges
+ * and orientations, and every start that ties with the minimum corresponds
+ * to an automorphism. the symmetries are thus a by-product of computing
+ * the code. the orbits of the edges follow from the labelings of the tied
+ * breadth first searches, which map the vertices onto each other.
+ * ---------------------------------------------------------------------- */
+
+struct Symmetry {
+    // the number of automorphisms (including orientation reversing ones
+    // for planar triangulations)
+    int automorphisms;
+
+    // for every halfedge, the smallest index of a halfedge whose edge is
+    // in the same orbit under the automorphisms. a halfedge represents its
+    // orbit if this is its own index.
+    std::vector<int> orbits;
 };
 
 /* ---------------------------------------------------------------------- *
@@ -267,15 +379,37 @@ public:
     // at the specified halfedge
     Code(const Triangulation &triangulation, Halfedge *halfedge);
 
+    // constructor that computes code from the specified triangulation and
+    // sets the number of its automorphisms
+    Code(const Triangulation &triangulation, int &automorphisms);
+
+    // constructor that computes code from the specified triangulation and
+    // sets its automorphisms and orbits of edges
+    Code(const Triangulation &triangulation, Symmetry &symmetry);
+
     // constructor that copies the specified code
     Code(const Code &code);
 
     // constructor that copies the code from the specified vector
     Code(const std::vector<unsigned char> &code);
 
+    // constructor that copies the code from the specified array of symbols
+    Code(const unsigned char *symbols, int length);
+
+    // constructor that copies the code from the specified view
+    Code(const CodeView &code);
+
     // destructor
     ~Code();
 
+    // assigns the specified code to this code
+    Code &operator=(const Code &code);
+
+    // replaces this code by the code of the specified triangulation,
+    // reusing the symbol array if the length does not change. returns the
+    // number of automorphisms of the triangulation.
+    int assign(const Triangulation &triangulation);
+
 private:
     // the char array representing the actual code
     unsigned char *code_;
@@ -288,23 +422,51 @@ private:
 
     // updates the this code for the specified triangulation starting at
     // the specified halfedge and using the specified orientation.
-    // the code is updated if the new code is lexicographically smaller
-    void update(const Triangulation &triangulation, Halfedge *halfedge, bool clockwise);
-
-    // computes the code for the specified triangulation
-    void compute_code(const Triangulation &triangulation);
+    // the code is updated if the new code is lexicographically smaller.
+    // returns a negative value if the new code is lexicographically
+    // smaller, zero if it is equal and a positive value if it is greater.
+    int update(const Triangulation &triangulation, Halfedge *halfedge, bool clockwise);
+
+    // computes the code for the specified triangulation and returns the
+    // number of its automorphisms
+    int compute_code(const Triangulation &triangulation);
+
+    // resets all symbols and computes the minimal code over all starting
+    // halfedges of minimal degree (the code must have the right length).
+    // returns the number of starts that yield the minimal code, i.e., the
+    // number of automorphisms. if labelings is given, the vertex labels of
+    // these starts are appended to it.
+    int minimize(const Triangulation &triangulation, std::vector<int> *labelings);
+
+    // minimizes the code of a triangulation of the specified class
+    template <class TriangulationClass>
+    int minimize(const Triangulation &triangulation, std::vector<int> *labelings);
+
+    // computes the orbits of the edges from the vertex labels of all starts
+    // that yield the minimal code
+    static void compute_orbits(const Triangulation &triangulation, const std::vector<int> &labelings,
+                               std::vector<int> &orbits);
 
     // computes the code for the specified triangulation starting at the
     // specified halfedge
     void compute_code(const Triangulation &triangulation, Halfedge *halfedge);
 
 public:
+    // returns the number of automorphisms of the specified triangulation,
+    // i.e., the number of starting halfedges and orientations that yield
+    // its code (including orientation reversing automorphisms). it is
+    // counted while computing the code.
+    static int automorphisms(const Triangulation &triangulation);
+
     // sets the i-th symbol of the code
     void set_symbol(int i, unsigned char symbol);
 
     // returns the i-th symbol of the code
     unsigned char symbol(int i) const;
 
+    // returns the array of symbols
+    const unsigned char *symbols() const;
+
     // returns the length of the code
     int length() const;
 
@@ -334,6 +496,50 @@ public:
     void write_to_stream(std::ostream &output_stream) const;
 };
 
+/* ---------------------------------------------------------------------- *
+ * declaration of the code view class
+ *
+ * a code view refers to the symbols of a code that are stored elsewhere,
+ * e.g., in a code table, without owning them. it is only valid as long as
+ * the symbols are.
+ * ---------------------------------------------------------------------- */
+
+class CodeView {
+public:
+    // constructor that refers to the specified array of symbols
+    CodeView(const unsigned char *symbols, int length);
+
+    // constructor that refers to the symbols of the specified code
+    CodeView(const Code &code);
+
+private:
+    // the symbols
+    const unsigned char *symbols_;
+
+    // the length of the code
+    int length_;
+
+public:
+    // returns the i-th symbol of the code
+    unsigned char symbol(int i) const;
+
+    // returns the array of symbols
+    const unsigned char *symbols() const;
+
+    // returns the length of the code
+    int length() const;
+
+    // returns whether the code is equal to the specified code or not
+    bool operator==(const CodeView &other) const;
+
+    // returns whether the code is not equal to the specified code or not
+    bool operator!=(const CodeView &other) const;
+
+    // returns whether the code lexicographically smaller than the specified
+    // code or not
+    bool operator<(const CodeView &other) const;
+};
+
 #endif
 
 /* ---------------------------------------------------------------------- *
@@ -0,0 +1,155 @@
+/* ---------------------------------------------------------------------- *
+ * twocenter.cpp
+ * ---------------------------------------------------------------------- */
+
+#include "twocenter.hpp"
+#include "distancematrix.hpp"
+
+#include <thread>
+#include <algorithm>
+
+/* ---------------------------------------------------------------------- *
+ * helper functions
+ * ---------------------------------------------------------------------- */
+
+// the distances of all vertices as full rows with two distances per byte
+struct PackedRows {
+    // the number of vertices
+    int size;
+
+    // the number of bytes per row
+    int stride;
+
+    // the rows
+    std::vector<unsigned char> data;
+
+    // the single center bound of every vertex
+    std::vector<int> bounds;
+
+    // the diameter
+    int diameter;
+};
+
+// computes the two center bound of the centers with the specified rows.
+// returns as soon as the specified upper bound is reached.
+static int pair_bound(const PackedRows &rows, int c1, int c2, int upper) {
+    // joint histogram of the distances to both centers
+    long counts[256] = {0};
+    const unsigned char *row_1 = rows.data.data() + (long) c1 * rows.stride;
+    const unsigned char *row_2 = rows.data.data() + (long) c2 * rows.stride;
+    for (int i = 0; i < rows.stride; ++i) {
+        counts[((row_1[i] & 0x0f) << 4) | (row_2[i] & 0x0f)]++;
+        counts[(row_1[i] & 0xf0) | (row_2[i] >> 4)]++;
+    }
+
+    // the padding nibble of odd sizes counts as a vertex at distances (0, 0)
+    if (rows.size % 2 == 1) { counts[0]--; }
+
+    // classes of vertices with the same pair of distances
+    int classes[256];
+    int count = 0;
+    for (int i = 0; i < 256; ++i) {
+        if (counts[i] > 0) { classes[count++] = i; }
+    }
+
+    // best pair of vertices from two classes (or twice the same class)
+    int bound = 0;
+    for (int i = 0; i < count; ++i) {
+        int x_i = classes[i] >> 4;
+        int y_i = classes[i] & 0x0f;
+        for (int j = (counts[classes[i]] > 1) ? i : i + 1; j < count; ++j) {
+            int x_j = classes[j] >> 4;
+            int y_j = classes[j] & 0x0f;
+            bound = std::max(bound, std::min(x_i + x_j, y_i + y_j));
+        }
+        if (bound >= upper) { return bound; }
+    }
+    return bound;
+}
+
+// computes the bounds of all pairs with every threads-th first center
+// starting with the specified one
+static void compute_bounds(const PackedRows *rows, int first, int threads, std::vector<long> *histogram) {
+    int size = rows->size;
+    for (int c1 = first; c1 < size; c1 += threads) {
+        for (int c2 = c1; c2 < size; ++c2) {
+            int bound;
+            int upper = std::min(rows->bounds[c1], rows->bounds[c2]);
+            if (c1 == c2) {
+                bound = rows->bounds[c1];
+            } else if (upper == rows->diameter) {
+                // every bound is at least the diameter
+                bound = upper;
+            } else {
+                bound = pair_bound(*rows, c1, c2, upper);
+            }
+
+            if ((int) histogram->size() <= bound) { histogram->resize(bound + 1, 0); }
+            (*histogram)[bound]++;
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * two center bounds
+ * ---------------------------------------------------------------------- */
+
+int single_center_bound(const std::vector<unsigned char> &distances) {
+    int eccentricity = 0;
+    int count = 0;
+    for (unsigned char distance : distances) {
+        if (distance > eccentricity) {
+            eccentricity = distance;
+            count = 0;
+        }
+        if (distance == eccentricity) { count++; }
+    }
+    if (distances.size() < 2) { return 0; }
+    return (count == 1) ? 2 * eccentricity - 1 : 2 * eccentricity;
+}
+
+bool two_center_histogram(const Graph &graph, int threads, std::vector<long> &histogram) {
+    histogram.clear();
+
+    // pack full rows of the distance matrix
+    PackedRows rows;
+    rows.size = (int) graph.size();
+    rows.stride = (rows.size + 1) / 2;
+    rows.data.assign((long) rows.size * rows.stride, 0);
+    rows.bounds.resize(rows.size);
+    rows.diameter = 0;
+    {
+        DistanceMatrix distances;
+        if (!distances.compute(graph, threads)) { return false; }
+
+        std::vector<unsigned char> row;
+        for (int i = 0; i < rows.size; ++i) {
+            distances.row(i, row);
+            unsigned char *position = rows.data.data() + (long) i * rows.stride;
+            for (int j = 0; j < rows.size; ++j) {
+                position[j / 2] |= (j % 2 == 0) ? row[j] : row[j] << 4;
+                rows.diameter = std::max(rows.diameter, (int) row[j]);
+            }
+            rows.bounds[i] = single_center_bound(row);
+        }
+    }
+
+    // compute bounds
+    threads = std::max(1, std::min(threads, rows.size));
+    std::vector<std::vector<long> > histograms(threads);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; ++i) {
+        workers.push_back(std::thread(compute_bounds, &rows, i, threads, &histograms[i]));
+    }
+    for (std::thread &worker : workers) { worker.join(); }
+
+    for (const std::vector<long> &list : histograms) {
+        if (histogram.size() < list.size()) { histogram.resize(list.size(), 0); }
+        for (int i = 0; i < (int) list.size(); ++i) { histogram[i] += list[i]; }
+    }
+    return true;
+}
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
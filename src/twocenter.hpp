@@ -0,0 +1,41 @@
+/* ---------------------------------------------------------------------- *
+ * twocenter.hpp
+ * ---------------------------------------------------------------------- */
+
+#ifndef __FGG_TWO_CENTER__
+#define __FGG_TWO_CENTER__
+
+#include <vector>
+
+typedef std::vector<std::vector<int> > Graph;
+
+/* ---------------------------------------------------------------------- *
+ * two center bounds
+ *
+ * the two center bound of a pair of vertices c1 and c2 is the largest
+ * value of min(d(a, c1) + d(b, c1), d(a, c2) + d(b, c2)) over all pairs of
+ * distinct vertices a and b, i.e., the length of a path between any two
+ * vertices through the better of both centers.
+ *
+ * the bound only depends on which pairs of distances (d(t, c1), d(t, c2))
+ * occur and whether they occur more than once, so it is computed from a
+ * joint histogram of two rows of the distance matrix instead of all pairs
+ * of vertices. moreover, every bound lies between the diameter and the
+ * single center bounds of c1 and c2, hence pairs where these coincide are
+ * skipped.
+ * ---------------------------------------------------------------------- */
+
+// computes the single center bound of the vertex with the specified
+// distances, i.e., the largest sum of the distances of two distinct vertices
+int single_center_bound(const std::vector<unsigned char> &distances);
+
+// computes the histogram of the two center bounds of all pairs c1 <= c2 of
+// vertices of the specified connected graph using the specified number of
+// threads. returns false if the diameter of the graph is too large.
+bool two_center_histogram(const Graph &graph, int threads, std::vector<long> &histogram);
+
+#endif
+
+/* ---------------------------------------------------------------------- *
+ * end of file
+ * ---------------------------------------------------------------------- */
@@ -4,11 +4,35 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
 #include <assert.h>
 #include "src/triangulation.hpp"
 #include "src/flipgraph.hpp"
 #include "src/functions.hpp"
 #include "src/options.hpp"
+#include "src/codeio.hpp"
+#include "src/plantri.hpp"
+#include "src/codeindex.hpp"
+#include "src/query.hpp"
+#include "src/search.hpp"
+#include "src/flipview.hpp"
+#include "src/labeled.hpp"
+#include "src/sampler.hpp"
+#include "src/spectral.hpp"
+#include "src/distancematrix.hpp"
+#include "src/twocenter.hpp"
+#include "src/profile.hpp"
+#include "src/progress.hpp"
 
 /* ---------------------------------------------------------------------- *
  * helper functions
@@ -22,6 +46,32 @@ void print_list(std::vector<int> &list) {
     std::cout << std::endl;
 }
 
+// the number of failed checks
+static int failures = 0;
+
+// reports the check with the specified name if its condition is false
+static void check(bool condition, const std::string &name) {
+    if (!condition) {
+        std::cout << "FAILED: " << name << std::endl;
+        failures++;
+    }
+}
+
+// returns the code in the specified text format, which need not be the
+// canonical code of its triangulation
+static Code parse(const std::string &text) {
+    std::vector<unsigned char> symbols;
+    const char *end = parse_code(text.data(), text.data() + text.size(), symbols);
+    assert(end != nullptr);
+    return Code(symbols);
+}
+
+// maps the codes of the triangulations to their indices in the flip graph
+static void code_indices(const FlipGraph &flip_graph, std::map<Code, int> &indices) {
+    int size = (int) flip_graph.graph().size();
+    for (int i = 0; i < size; ++i) { indices[Code(flip_graph.code(i))] = i; }
+}
+
 /* ---------------------------------------------------------------------- *
  * dominant canonical triangulations
  * ---------------------------------------------------------------------- */
@@ -32,9 +82,6 @@ void dominant_canonical_triangulations(int n) {
     Triangulation canonical(n);
     Code canonical_code(canonical);
 
-    Triangulation twin_star(n, TRIANGULATION_DOMINANT_TWIN_STAR);
-    Code twin_star_code(twin_star);
-
     Triangulation zig_zag(n, TRIANGULATION_DOMINANT_ZIG_ZAG);
     Code zig_zag_code(zig_zag);
 
@@ -58,14 +105,14 @@ void dominant_canonical_triangulations(int n) {
         int last = histogram[distance];
         int bound = (last == 1) ? 2 * distance - 1 : 2 * distance;
 
-        if (bounds.size() <= bound) {
+        if ((int) bounds.size() <= bound) {
             bounds.resize(bound + 1, 0);
         }
         bounds[bound]++;
 
         Triangulation triangulation(flip_graph.code(i));
         if (triangulation.has_dominant_vertex()) {
-            if (dominant_bounds.size() <= bound) {
+            if ((int) dominant_bounds.size() <= bound) {
                 dominant_bounds.resize(bound + 1, 0);
             }
             dominant_bounds[bound]++;
@@ -74,9 +121,6 @@ void dominant_canonical_triangulations(int n) {
         if (i == 0) {
             std::cout << "canonical : " << bound << std::endl;
         }
-        if (flip_graph.code(i) == twin_star_code) {
-            std::cout << "twin star: " << bound << std::endl;
-        }
         if (flip_graph.code(i) == zig_zag_code) {
             std::cout << "zig zag: " << bound << std::endl;
         }
@@ -92,26 +136,26 @@ void dominant_canonical_triangulations(int n) {
 }
 
 /* ---------------------------------------------------------------------- *
- * main function
+ * farthest triangulations
  * ---------------------------------------------------------------------- */
 
-int main(int argc, char *argv[]) {
-    char *option_n = get_cmd_option(argc, argv, "-n");
-    int n = (option_n) ? std::stoi(option_n) : 4;
-
+// writes the triangulations farthest from the canonical triangulation to
+// the files 0.dot, 1.dot, ...
+void write_farthest_triangulations(int n) {
     FlipGraph flip_graph;
     flip_graph.compute(n);
 
     std::vector<int> distances;
     distance_list(flip_graph.graph(), 0, distances);
 
+    int size = (int) distances.size();
     int max_dist = 0;
-    for (int i = 0; i < distances.size(); i++) {
+    for (int i = 0; i < size; i++) {
         max_dist = std::max(max_dist, distances[i]);
     }
 
     int count = 0;
-    for (int i = 0; i < distances.size(); ++i) {
+    for (int i = 0; i < size; ++i) {
         if (distances[i] == max_dist) {
             std::ofstream output;
             output.open(std::to_string(count++) + ".dot");
@@ -122,10 +166,937 @@ int main(int argc, char *argv[]) {
             output.close();
         }
     }
+}
+
+/* ---------------------------------------------------------------------- *
+ * code files
+ * ---------------------------------------------------------------------- */
+
+void test_code_files(int n, int triangulation_class) {
+    std::string name = "code files n=" + std::to_string(n) + " class=" + std::to_string(triangulation_class);
+    FlipGraph flip_graph;
+    flip_graph.set_triangulation_class(triangulation_class);
+    flip_graph.compute(n);
+    const CodeTable &codes = flip_graph.codes();
+
+    // binary format
+    std::stringstream binary_stream;
+    write_codes_binary(binary_stream, codes);
+    CodeTable binary_codes;
+    check(read_codes_binary(binary_stream, binary_codes), name + " binary read");
+    check(binary_codes.size() == codes.size() && binary_codes.length() == codes.length(), name + " binary size");
+    for (uint64_t i = 0; i < codes.size() && i < binary_codes.size(); ++i) {
+        check(binary_codes[i] == codes[i], name + " binary code " + std::to_string(i));
+    }
+
+    // a record whose first vertex is its own neighbor is rejected
+    std::string bytes = binary_stream.str();
+    bytes[bytes.size() - codes.length() + 1] = 1;
+    std::stringstream corrupt_stream(bytes);
+    CodeTable corrupt_codes;
+    check(!read_codes_binary(corrupt_stream, corrupt_codes), name + " binary invalid record");
+
+    // text format
+    std::stringstream text_stream;
+    write_codes_text(text_stream, codes);
+    std::vector<Code> text_codes;
+    check(read_codes_text(text_stream, text_codes), name + " text read");
+    check(text_codes.size() == codes.size(), name + " text size");
+    for (uint64_t i = 0; i < codes.size() && i < text_codes.size(); ++i) {
+        check(CodeView(text_codes[i]) == codes[i], name + " text code " + std::to_string(i));
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * canonical codes
+ * ---------------------------------------------------------------------- */
+
+void test_canonical_codes() {
+    // the codes of the flip graph are canonical already
+    FlipGraph flip_graph;
+    flip_graph.compute(8);
+    for (int i = 0; i < (int) flip_graph.graph().size(); ++i) {
+        Code code(flip_graph.code(i));
+        check(canonicalize_code(code) && code == Code(flip_graph.code(i)), "canonical code " + std::to_string(i));
+    }
+
+    // two codes of the same triangulation from different starting halfedges
+    Code code_a = parse("7 bcd adec abefgd acgfeb bdfc cedg cfd");
+    Code code_b = parse("7 bcde aec abefgd acge adgfcb ceg cfed");
+    check(!(code_a == code_b), "non-canonical codes differ");
+    check(canonicalize_code(code_a) && canonicalize_code(code_b) && code_a == code_b, "non-canonical codes");
+    std::vector<Code> path;
+    check(flip_distance(code_a, code_b, path) == 0, "non-canonical codes distance");
+
+    // the heuristic solvers canonicalize their codes themselves
+    Code raw_a = parse("7 bcd adec abefgd acgfeb bdfc cedg cfd");
+    Code raw_b = parse("7 bcde aec abefgd acge adgfcb ceg cfed");
+    SearchStatistics statistics;
+    check(flip_distance_astar(raw_a, raw_b, path, statistics) == 0 && path.size() == 1 && path[0] == code_a,
+          "non-canonical codes astar");
+    check(flip_distance_idastar(raw_a, raw_b, path, statistics) == 0 && path.size() == 1 && path[0] == code_a,
+          "non-canonical codes idastar");
+    Code zig_zag(Triangulation(7, TRIANGULATION_DOMINANT_ZIG_ZAG));
+    int expected = flip_distance(zig_zag, code_a, path);
+    check(expected > 0 && flip_distance_astar(zig_zag, raw_b, path, statistics) == expected
+          && path.back() == code_a, "non-canonical target astar");
+    check(flip_distance_idastar(zig_zag, raw_b, path, statistics) == expected && path.back() == code_a,
+          "non-canonical target idastar");
+
+    // the center of a ball is canonicalized as well
+    FlipGraph raw_ball, ball;
+    raw_ball.compute(raw_a, 2);
+    ball.compute(code_a, 2);
+    std::vector<int> raw_histogram, histogram;
+    distance_histogram(raw_ball.graph(), 0, raw_histogram);
+    distance_histogram(ball.graph(), 0, histogram);
+    check(raw_ball.code(0) == code_a && raw_histogram[0] == 1 && raw_histogram == histogram,
+          "non-canonical ball center");
+
+    // codes of the wrong length or with a face that is not a triangle
+    Code truncated(code_a.symbols(), code_a.length() - 1);
+    check(!canonicalize_code(truncated), "truncated code");
+    Code reversed = parse("4 bcd acd abd acb");
+    check(!canonicalize_code(reversed), "reversed rotation code");
+
+    // the symbols of the largest codes still fit into a byte
+    Triangulation largest(MAX_CODE_ORDER);
+    check(Code::automorphisms(largest) > 0, "automorphisms of the largest codes");
+}
+
+/* ---------------------------------------------------------------------- *
+ * symmetries
+ * ---------------------------------------------------------------------- */
+
+// computes the rotation system of the bipyramid over a k-gon (the double
+// wheel), whose apexes are the vertices 1 and 2
+static void bipyramid(int k, std::vector<int> &rotation_system) {
+    rotation_system.clear();
+    for (int i = 0; i < k; ++i) { rotation_system.push_back(3 + i); }
+    rotation_system.push_back(0);
+    for (int i = k - 1; i >= 0; --i) { rotation_system.push_back(3 + i); }
+    rotation_system.push_back(0);
+    for (int i = 0; i < k; ++i) {
+        rotation_system.push_back(1);
+        rotation_system.push_back(3 + (i + k - 1) % k);
+        rotation_system.push_back(2);
+        rotation_system.push_back(3 + (i + 1) % k);
+        rotation_system.push_back(0);
+    }
+}
+
+// returns the number of orbits of edges
+static int edge_orbits(const Symmetry &symmetry) {
+    int count = 0;
+    for (int i = 0; i < (int) symmetry.orbits.size(); ++i) {
+        if (symmetry.orbits[i] == i) { count++; }
+    }
+    return count;
+}
+
+void test_symmetries() {
+    // the octahedron is edge transitive, the other bipyramids have two
+    // orbits of edges (at the apexes and around the equator)
+    int automorphisms[] = {48, 20, 24, 28};
+    for (int k = 4; k <= 7; ++k) {
+        std::string name = "bipyramid k=" + std::to_string(k);
+        std::vector<int> rotation_system;
+        bipyramid(k, rotation_system);
+        check(is_valid_rotation_system(k + 2, rotation_system), name + " rotation system");
+        Triangulation triangulation(k + 2, rotation_system);
+        Symmetry symmetry;
+        Code code(triangulation, symmetry);
+        check(code == Code(triangulation), name + " code");
+        check(symmetry.automorphisms == automorphisms[k - 4], name + " automorphisms");
+        check(edge_orbits(symmetry) == (k == 4 ? 1 : 2), name + " edge orbits");
+    }
+
+    // flipping one edge of every orbit yields all neighbors
+    FlipGraph flip_graph;
+    flip_graph.compute(8);
+    for (int i = 0; i < (int) flip_graph.graph().size(); ++i) {
+        std::string name = "symmetries n=8 " + std::to_string(i);
+        Triangulation triangulation(Code(flip_graph.code(i)));
+        Symmetry symmetry;
+        Code code(triangulation, symmetry);
+        check(symmetry.automorphisms == flip_graph.automorphisms(i), name + " automorphisms");
+
+        std::set<Code> neighbors, orbit_neighbors;
+        std::set<int> orbits;
+        for (int j = 0; j < triangulation.size(); ++j) {
+            Halfedge *halfedge = triangulation.halfedge(j);
+            if (!triangulation.is_representative(halfedge) || !triangulation.is_flippable(halfedge)) { continue; }
+            triangulation.flip(halfedge);
+            Code neighbor(triangulation);
+            if (neighbor != code) { neighbors.insert(neighbor); }
+            if (neighbor != code && orbits.insert(symmetry.orbits[j]).second) { orbit_neighbors.insert(neighbor); }
+            triangulation.flip(halfedge);
+        }
+        check(neighbors == orbit_neighbors && (int) neighbors.size() == (int) flip_graph.graph()[i].size(),
+              name + " orbit neighbors");
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * planar code
+ * ---------------------------------------------------------------------- */
+
+void test_planar_code(int n, int triangulation_class) {
+    std::string name = "planar code n=" + std::to_string(n) + " class=" + std::to_string(triangulation_class);
+    FlipGraph flip_graph;
+    flip_graph.set_triangulation_class(triangulation_class);
+    flip_graph.compute(n);
+    int size = (int) flip_graph.graph().size();
+
+    std::stringstream stream;
+    PlanarCodeWriter writer(stream);
+    for (int i = 0; i < size; ++i) { writer.write(Triangulation(Code(flip_graph.code(i)))); }
 
+    PlanarCodeReader reader(stream);
+    Triangulation *triangulation;
+    int count = 0;
+    while ((triangulation = reader.next()) != nullptr) {
+        check(count < size && Code(*triangulation) == Code(flip_graph.code(count)),
+              name + " triangulation " + std::to_string(count));
+        delete triangulation;
+        count++;
+    }
+    check(count == size && !reader.failed(), name + " count");
+}
+
+// returns whether the reader rejects the graph with the specified rotation
+// system without building a triangulation
+static bool rejects_planar_code(int n, const std::vector<int> &rotation_system) {
+    std::string record(1, (char) n);
+    for (int entry : rotation_system) { record.push_back((char) entry); }
+    std::stringstream stream(record);
+    PlanarCodeReader reader(stream);
+    Triangulation *triangulation = reader.next();
+    delete triangulation;
+    return triangulation == nullptr && reader.failed() && reader.records() == 1;
+}
+
+void test_invalid_planar_code() {
+    // the rotation system of k4 as written by the writer
+    std::stringstream stream;
+    PlanarCodeWriter writer(stream);
+    writer.write(Triangulation(4));
+    PlanarCodeReader reader(stream);
+    std::vector<int> k4;
+    check(reader.read(k4) == 4, "planar code k4");
+    check(!rejects_planar_code(4, k4), "planar code valid k4");
+
+    // one reversed rotation makes a face that is not a triangle
+    std::vector<int> reversed = k4;
+    std::reverse(reversed.begin(), reversed.begin() + 3);
+    check(rejects_planar_code(4, reversed), "planar code reversed rotation");
+
+    // a neighbor that is out of range or the vertex itself
+    std::vector<int> out_of_range = k4;
+    out_of_range[0] = 5;
+    check(rejects_planar_code(4, out_of_range), "planar code out of range");
+    std::vector<int> loop = k4;
+    loop[0] = 1;
+    check(rejects_planar_code(4, loop), "planar code loop");
+
+    // a neighbor that occurs twice
+    std::vector<int> duplicate = k4;
+    duplicate[0] = duplicate[1];
+    check(rejects_planar_code(4, duplicate), "planar code duplicate");
+
+    // an edge that only occurs in the list of one of its vertices
+    writer.write(Triangulation(6));
+    std::vector<int> asymmetric;
+    check(reader.read(asymmetric) == 6, "planar code n=6");
+    std::vector<int>::iterator begin = asymmetric.begin();
+    bool replaced = false;
+    for (int i = 1; i <= 6 && !replaced; ++i) {
+        std::vector<int>::iterator end = std::find(begin, asymmetric.end(), 0);
+        for (int k = 1; k <= 6 && !replaced; ++k) {
+            if (k != i && std::find(begin, end, k) == end) {
+                *begin = k;
+                replaced = true;
+            }
+        }
+        begin = end + 1;
+    }
+    check(replaced && rejects_planar_code(6, asymmetric), "planar code asymmetric");
+}
+
+/* ---------------------------------------------------------------------- *
+ * sampling
+ * ---------------------------------------------------------------------- */
+
+// returns the sorted lines of the samples written with the specified settings
+static std::vector<std::string> sample_lines(const SamplerSettings &settings) {
+    std::stringstream stream;
+    SamplerStatistics statistics;
+    sample_triangulations(settings, stream, statistics);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(stream, line)) { lines.push_back(line); }
+    std::sort(lines.begin(), lines.end());
+    return lines;
+}
+
+void test_sampler(int n, bool unlabeled) {
+    std::string name = "sampler n=" + std::to_string(n) + " unlabeled=" + std::to_string(unlabeled);
+
+    // walkers with the same seed take the same steps
+    FlipWalker walker(n, 42, unlabeled);
+    FlipWalker same_walker(n, 42, unlabeled);
+    FlipWalker other_walker(n, 43, unlabeled);
+    walker.walk(1000);
+    same_walker.walk(1000);
+    other_walker.walk(1000);
+    check(walker.steps() == 1000 && walker.flips() == same_walker.flips(), name + " flips");
+    check(Code(walker.triangulation()) == Code(same_walker.triangulation()), name + " walker");
+    check(!(Code(walker.triangulation()) == Code(other_walker.triangulation())), name + " other seed");
+
+    // the samples only depend on the seed, not on the number of threads
+    SamplerSettings settings = {n, 4, 1, 200, 50, 20, unlabeled, 7, SAMPLE_FORMAT_CODE};
+    std::vector<std::string> lines = sample_lines(settings);
+    check(lines.size() == 80, name + " samples");
+    check(sample_lines(settings) == lines, name + " repeated");
+    settings.threads = 3;
+    check(sample_lines(settings) == lines, name + " threads");
+    settings.seed = 8;
+    check(sample_lines(settings) != lines, name + " seed");
+
+    // the samples are codes of triangulations on n vertices
+    bool valid = true;
+    for (const std::string &line : lines) {
+        Code code = parse(line);
+        valid = valid && code.symbol(0) == n && canonicalize_code(code);
+    }
+    check(valid, name + " codes");
+}
+
+/* ---------------------------------------------------------------------- *
+ * code indices
+ * ---------------------------------------------------------------------- */
+
+// checks that the index finds the i-th code at index i and no other code
+static void check_code_index(const CodeIndex &code_index, const CodeTable &codes, const std::string &name) {
+    check(code_index.size() == (int) codes.size(), name + " size");
+    for (uint64_t i = 0; i < codes.size(); ++i) {
+        check(code_index.lookup(codes[i].symbols(), codes.length()) == (int) i, name + " code " + std::to_string(i));
+    }
+    check(codes.size() == 0 || code_index.lookup(codes[0].symbols(), codes.length() - 1) == -1, name + " length");
+}
+
+void test_code_index(int n, int triangulation_class) {
+    std::string name = "code index n=" + std::to_string(n) + " class=" + std::to_string(triangulation_class);
+    FlipGraph flip_graph;
+    flip_graph.set_triangulation_class(triangulation_class);
+    flip_graph.compute(n);
+    CodeIndex code_index;
+    code_index.build(flip_graph.codes());
+    check_code_index(code_index, flip_graph.codes(), name + " built");
+
+    // the written index is memory mapped as is
+    const char *path = "test_code_index.bin";
+    std::ofstream output(path, std::ios::out | std::ios::binary);
+    code_index.write_to_stream(output);
+    output.close();
+    CodeIndex mapped_index;
+    check(mapped_index.open(path), name + " open");
+    check_code_index(mapped_index, flip_graph.codes(), name + " mapped");
+
+    // an index without buckets is rejected
+    std::ifstream input(path, std::ios::in | std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    input.close();
+    std::fill(bytes.begin() + 24, bytes.begin() + 32, 0);
+    output.open(path, std::ios::out | std::ios::binary);
+    output << bytes;
+    output.close();
+    check(!mapped_index.open(path), name + " no buckets");
+    std::remove(path);
+}
+
+/* ---------------------------------------------------------------------- *
+ * queries
+ * ---------------------------------------------------------------------- */
+
+// returns the answer of the query server to the specified query
+static std::string answer(QueryServer &server, const std::string &query) {
+    std::stringstream stream;
+    server.answer(query, stream);
+    return stream.str();
+}
+
+void test_queries() {
+    FlipGraph flip_graph;
+    flip_graph.compute(7);
+    CodeIndex code_index;
+    code_index.build(flip_graph.codes());
+    QueryServer server(flip_graph, code_index);
+
+    // a relabeled code is found by the canonical code of its triangulation
+    std::map<Code, int> indices;
+    code_indices(flip_graph, indices);
+    Code code = parse("7 bcde aec abefgd acge adgfcb ceg cfed");
+    Code canonical(code);
+    check(canonicalize_code(canonical) && !(code == canonical), "query code is relabeled");
+    std::string index = std::to_string(indices[canonical]);
+    check(answer(server, "index 7 bcde aec abefgd acge adgfcb ceg cfed") == index + "\n", "query relabeled code");
+    check(answer(server, "distance 7 bcde aec abefgd acge adgfcb ceg cfed #" + index) == "0\n",
+          "query relabeled code distance");
+
+    // codes of other orders are not contained, invalid codes are errors
+    check(answer(server, "index 5 bcd adec abed aceb bdc") == "-1\n", "query other order");
+    check(answer(server, "index 4 bcd acd abd acb") == "error\n", "query invalid code");
+}
+
+/* ---------------------------------------------------------------------- *
+ * flip distances
+ * ---------------------------------------------------------------------- */
+
+// compares the distances of the solvers with the distances in the flip
+// graph from the specified number of sources to every step-th triangulation
+void test_flip_distances(int n, int sources, int step) {
+    std::string name = "flip distances n=" + std::to_string(n);
+    FlipGraph flip_graph;
+    flip_graph.compute(n);
+    int size = (int) flip_graph.graph().size();
+
+    ExplicitFlipGraph explicit_view(flip_graph.graph());
+    ImplicitFlipGraph implicit_view;
+    std::vector<int> distances;
+    std::vector<int> histogram;
+    std::vector<long> layers;
+    std::vector<Code> path;
+    SearchStatistics statistics;
+    for (int source = 0; source < size && source < sources; ++source) {
+        distance_list(flip_graph.graph(), source, distances);
+        distance_histogram(flip_graph.graph(), source, histogram);
+        Code source_code(flip_graph.code(source));
+        std::string layer_name = name + " " + std::to_string(source) + " layer sizes";
+        layer_sizes(explicit_view, source, -1, layers);
+        check(std::vector<int>(layers.begin(), layers.end()) == histogram, layer_name + " explicit");
+        layer_sizes(implicit_view, source_code, -1, layers, 4);
+        check(std::vector<int>(layers.begin(), layers.end()) == histogram, layer_name + " implicit");
+        layer_sizes(implicit_view, source_code, 2, layers);
+        check(layers.size() == 3 && std::equal(layers.begin(), layers.end(), histogram.begin()),
+              layer_name + " radius");
+
+        // the distance kernels agree on both views
+        std::string kernel_name = name + " " + std::to_string(source);
+        ImplicitFlipGraph::VertexMap<int> implicit_distances;
+        distance_list(implicit_view, std::vector<Code>(1, source_code), implicit_distances, -1, 4);
+        bool equal = (int) implicit_distances.size() == size;
+        for (int i = 0; i < size && equal; ++i) {
+            equal = implicit_distances[Code(flip_graph.code(i))] == distances[i];
+        }
+        check(equal, kernel_name + " distance list implicit");
+        distance_list(implicit_view, std::vector<Code>(1, source_code), implicit_distances, 2);
+        check((int) implicit_distances.size() == histogram[0] + histogram[1] + histogram[2],
+              kernel_name + " distance list radius");
+        int expected = (int) histogram.size() - 1;
+        check(eccentricity(explicit_view, source) == expected && eccentricity(implicit_view, source_code) == expected,
+              kernel_name + " eccentricity");
+        for (int target = 0; target < size; target += step) {
+            std::string pair = " " + std::to_string(source) + "-" + std::to_string(target);
+            Code target_code(flip_graph.code(target));
+            check(bidirectional_distance(explicit_view, source, target) == distances[target],
+                  name + pair + " explicit");
+            check(flip_distance(source_code, target_code, path) == distances[target], name + pair + " bidirectional");
+            check((int) path.size() == distances[target] + 1 && path.front() == source_code
+                  && path.back() == target_code, name + pair + " bidirectional path");
+            check(flip_distance(source_code, target_code, path, 4) == distances[target]
+                  && (int) path.size() == distances[target] + 1, name + pair + " bidirectional threads");
+            check(flip_distance_astar(source_code, target_code, path, statistics) == distances[target],
+                  name + pair + " astar");
+            check(flip_distance_idastar(source_code, target_code, path, statistics) == distances[target],
+                  name + pair + " idastar");
+        }
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * balls
+ * ---------------------------------------------------------------------- */
+
+// compares the ball of the specified radius around a triangulation with
+// the subgraph of the flip graph that is induced by its triangulations
+void test_ball(int n, int center, int radius, int threads) {
+    std::string name = "ball n=" + std::to_string(n) + " radius=" + std::to_string(radius)
+                       + " threads=" + std::to_string(threads);
+    FlipGraph flip_graph;
+    flip_graph.compute(n);
+    std::map<Code, int> indices;
+    code_indices(flip_graph, indices);
+    std::vector<int> distances;
+    distance_list(flip_graph.graph(), center, distances);
+
+    FlipGraph ball;
+    ball.compute(Code(flip_graph.code(center)), radius, threads);
+    int size = (int) ball.graph().size();
+    int expected = 0;
+    for (int distance : distances) { expected += (distance <= radius) ? 1 : 0; }
+    check(size == expected, name + " size");
+
+    std::vector<int> ball_distances;
+    distance_list(ball.graph(), 0, ball_distances);
+    for (int i = 0; i < size; ++i) {
+        int index = indices[Code(ball.code(i))];
+        check(ball_distances[i] == distances[index], name + " distance " + std::to_string(i));
+        std::set<int> neighbors;
+        for (int neighbor : ball.graph()[i]) { neighbors.insert(indices[Code(ball.code(neighbor))]); }
+        std::set<int> expected_neighbors;
+        for (int neighbor : flip_graph.graph()[index]) {
+            if (distances[neighbor] <= radius) { expected_neighbors.insert(neighbor); }
+        }
+        check(neighbors == expected_neighbors && neighbors.size() == ball.graph()[i].size(),
+              name + " neighbors " + std::to_string(i));
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * memory limit
+ * ---------------------------------------------------------------------- */
+
+// computes the flip graph on n vertices with the specified memory limit
+// and checks that it is either complete or reported as incomplete
+static bool complete_within(int n, long limit, const FlipGraph &expected, const std::string &name) {
+    FlipGraph flip_graph;
+    flip_graph.set_memory_limit(limit);
+    if (!flip_graph.compute(n)) { return false; }
+    bool equal = flip_graph.graph() == expected.graph() && flip_graph.stores_codes();
+    for (int i = 0; equal && i < (int) expected.graph().size(); ++i) {
+        equal = flip_graph.code(i) == expected.code(i);
+    }
+    check(equal, name + " complete");
+    return true;
+}
+
+void test_memory_limit(int n) {
+    std::string name = "memory limit n=" + std::to_string(n);
+    FlipGraph expected;
+    expected.compute(n);
+    long peak = expected.memory_usage().total();
+
+    // the queue is degraded just below the peak, a tiny limit fails
+    check(complete_within(n, peak, expected, name + " peak"), name + " peak");
+    check(!complete_within(n, 1024, expected, name + " tiny"), name + " tiny");
+    complete_within(n, peak / 2, expected, name + " half");
+}
+
+/* ---------------------------------------------------------------------- *
+ * spectra
+ * ---------------------------------------------------------------------- */
+
+// computes the distinct eigenvalues of the normalized adjacency matrix of
+// the specified graph in decreasing order with the jacobi method
+static void dense_eigenvalues(const Graph &graph, std::vector<double> &eigenvalues) {
+    int size = (int) graph.size();
+    std::vector<std::vector<double> > a(size, std::vector<double>(size, 0));
+    for (int i = 0; i < size; ++i) {
+        for (int j : graph[i]) { a[i][j] = 1 / std::sqrt((double) graph[i].size() * graph[j].size()); }
+    }
+
+    // rotate until the off diagonal entries vanish
+    for (int sweep = 0; sweep < 100; ++sweep) {
+        double off = 0;
+        for (int p = 0; p < size; ++p) {
+            for (int q = p + 1; q < size; ++q) { off += a[p][q] * a[p][q]; }
+        }
+        if (off < 1e-24) { break; }
+        for (int p = 0; p < size; ++p) {
+            for (int q = p + 1; q < size; ++q) {
+                if (std::fabs(a[p][q]) < 1e-300) { continue; }
+                double theta = (a[q][q] - a[p][p]) / (2 * a[p][q]);
+                double t = (theta >= 0 ? 1 : -1) / (std::fabs(theta) + std::sqrt(theta * theta + 1));
+                double c = 1 / std::sqrt(t * t + 1);
+                double s = t * c;
+                for (int k = 0; k < size; ++k) {
+                    double kp = a[k][p];
+                    double kq = a[k][q];
+                    a[k][p] = c * kp - s * kq;
+                    a[k][q] = s * kp + c * kq;
+                }
+                for (int k = 0; k < size; ++k) {
+                    double pk = a[p][k];
+                    double qk = a[q][k];
+                    a[p][k] = c * pk - s * qk;
+                    a[q][k] = s * pk + c * qk;
+                }
+            }
+        }
+    }
+
+    std::vector<double> diagonal(size);
+    for (int i = 0; i < size; ++i) { diagonal[i] = a[i][i]; }
+    std::sort(diagonal.rbegin(), diagonal.rend());
+    eigenvalues.clear();
+    for (double value : diagonal) {
+        if (eigenvalues.empty() || eigenvalues.back() - value > 1e-8) { eigenvalues.push_back(value); }
+    }
+}
+
+void test_spectrum(int n, int triangulation_class) {
+    std::string name = "spectrum n=" + std::to_string(n) + " class=" + std::to_string(triangulation_class);
+    FlipGraph flip_graph;
+    flip_graph.set_triangulation_class(triangulation_class);
+    flip_graph.compute(n);
+    const Graph &graph = flip_graph.graph();
+    std::vector<double> expected;
+    dense_eigenvalues(graph, expected);
+
+    // the krylov space of the lanczos method holds every distinct
+    // eigenvalue once
+    std::vector<double> eigenvalues;
+    top_eigenvalues(graph, 3, (int) graph.size(), false, 2, eigenvalues);
+    check(eigenvalues.size() == std::min<std::size_t>(3, expected.size()), name + " count");
+    for (std::size_t k = 0; k < eigenvalues.size() && k < expected.size(); ++k) {
+        check(std::fabs(eigenvalues[k] - expected[k]) < 1e-6, name + " eigenvalue " + std::to_string(k));
+    }
+    top_eigenvalues(graph, 2, (int) graph.size(), true, 1, eigenvalues);
+    check(eigenvalues.size() == 2 && std::fabs(eigenvalues[1] - (1 + expected[1]) / 2) < 1e-6, name + " lazy");
+}
+
+/* ---------------------------------------------------------------------- *
+ * distance matrices
+ * ---------------------------------------------------------------------- */
+
+// checks the distances of the matrix against breadth first searches
+static void check_distance_matrix(const DistanceMatrix &matrix, const Graph &graph, const std::string &name) {
+    int size = (int) graph.size();
+    check(matrix.size() == size, name + " size");
+    std::vector<int> distances;
+    std::vector<unsigned char> row;
+    bool equal = true;
+    for (int i = 0; i < size && equal; ++i) {
+        distance_list(graph, i, distances);
+        matrix.row(i, row);
+        for (int j = 0; j < size; ++j) {
+            equal = equal && matrix.get(i, j) == distances[j] && matrix.get(j, i) == distances[j]
+                    && row[j] == distances[j];
+        }
+    }
+    check(equal, name + " distances");
+}
+
+void test_distance_matrix(int n, int triangulation_class) {
+    std::string name = "distance matrix n=" + std::to_string(n) + " class=" + std::to_string(triangulation_class);
+    FlipGraph flip_graph;
+    flip_graph.set_triangulation_class(triangulation_class);
+    flip_graph.compute(n);
+    const Graph &graph = flip_graph.graph();
+
+    // the sources are split into blocks of 64 across the threads
+    DistanceMatrix matrix;
+    check(matrix.compute(graph, 3), name + " compute");
+    check_distance_matrix(matrix, graph, name);
+
+    const char *path = "test_distance_matrix.bin";
+    DistanceMatrix mapped_matrix;
+    check(mapped_matrix.compute(graph, 1, path), name + " mapped compute");
+    check_distance_matrix(mapped_matrix, graph, name + " mapped");
+    std::remove(path);
+}
+
+void test_invalid_distance_matrix() {
+    // a path of 17 vertices has a diameter of 16
+    Graph path(17);
+    for (int i = 0; i + 1 < 17; ++i) {
+        path[i].push_back(i + 1);
+        path[i + 1].push_back(i);
+    }
+    DistanceMatrix matrix;
+    check(!matrix.compute(path), "distance matrix too large diameter");
+    path.pop_back();
+    path.back().pop_back();
+    check(matrix.compute(path), "distance matrix diameter 15");
+    path.push_back(std::vector<int>());
+    check(!matrix.compute(path), "distance matrix disconnected");
+}
+
+/* ---------------------------------------------------------------------- *
+ * two center bounds
+ * ---------------------------------------------------------------------- */
+
+void test_two_center(int n, int triangulation_class) {
+    std::string name = "two center n=" + std::to_string(n) + " class=" + std::to_string(triangulation_class);
+    FlipGraph flip_graph;
+    flip_graph.set_triangulation_class(triangulation_class);
+    flip_graph.compute(n);
+    const Graph &graph = flip_graph.graph();
+    int size = (int) graph.size();
+    std::vector<std::vector<int> > distances(size);
+    for (int i = 0; i < size; ++i) { distance_list(graph, i, distances[i]); }
+
+    // the bounds of all pairs of centers by definition
+    std::vector<long> expected;
+    bool single_equal = true;
+    for (int c1 = 0; c1 < size; ++c1) {
+        for (int c2 = c1; c2 < size; ++c2) {
+            int bound = 0;
+            for (int a = 0; a < size; ++a) {
+                for (int b = a + 1; b < size; ++b) {
+                    bound = std::max(bound, std::min(distances[c1][a] + distances[c1][b],
+                                                     distances[c2][a] + distances[c2][b]));
+                }
+            }
+            if ((int) expected.size() <= bound) { expected.resize(bound + 1, 0); }
+            expected[bound]++;
+            if (c1 == c2) {
+                std::vector<unsigned char> row(distances[c1].begin(), distances[c1].end());
+                single_equal = single_equal && single_center_bound(row) == bound;
+            }
+        }
+    }
+    check(single_equal, name + " single center");
+
+    std::vector<long> histogram;
+    check(two_center_histogram(graph, 2, histogram) && histogram == expected, name + " histogram");
+}
+
+/* ---------------------------------------------------------------------- *
+ * reports
+ * ---------------------------------------------------------------------- */
+
+// skips the json value at the position and returns false if it is invalid.
+// strings are not checked for escapes, since the reports contain none.
+static bool skip_json(const std::string &text, std::size_t &position) {
+    while (position < text.size() && isspace((unsigned char) text[position])) { position++; }
+    if (position == text.size()) { return false; }
+    char first = text[position];
+    if (first == '{' || first == '[') {
+        char last = (first == '{') ? '}' : ']';
+        position++;
+        while (position < text.size() && isspace((unsigned char) text[position])) { position++; }
+        if (position < text.size() && text[position] == last) {
+            position++;
+            return true;
+        }
+        while (true) {
+            if (first == '{') {
+                if (!skip_json(text, position) || text[position - 1] != '"') { return false; }
+                while (position < text.size() && isspace((unsigned char) text[position])) { position++; }
+                if (position == text.size() || text[position++] != ':') { return false; }
+            }
+            if (!skip_json(text, position)) { return false; }
+            while (position < text.size() && isspace((unsigned char) text[position])) { position++; }
+            if (position == text.size()) { return false; }
+            char separator = text[position++];
+            if (separator == last) { return true; }
+            if (separator != ',') { return false; }
+        }
+    }
+    if (first == '"') {
+        std::size_t end = text.find('"', position + 1);
+        if (end == std::string::npos) { return false; }
+        position = end + 1;
+        return true;
+    }
+    for (const char *word : {"true", "false"}) {
+        std::size_t length = strlen(word);
+        if (text.compare(position, length, word) == 0) {
+            position += length;
+            return true;
+        }
+    }
+    const char *begin = text.c_str() + position;
+    char *end;
+    strtod(begin, &end);
+    if (end == begin) { return false; }
+    position += end - begin;
+    return true;
+}
+
+// returns true if the text is a single json object
+static bool is_json_object(const std::string &text) {
+    std::size_t position = 0;
+    if (!skip_json(text, position) || text[text.find_first_not_of(" \n")] != '{') { return false; }
+    return text.find_first_not_of(" \n", position) == std::string::npos;
+}
+
+void test_profile() {
+    check(is_json_object("{\"a\": [1, 2.5], \"b\": {}}\n") && !is_json_object("{\"a\": }")
+          && !is_json_object("{\"a\": 1} 2"), "json validator");
+    Profile profile(false);
+    int phase = profile.phase("setup");
+    profile.begin(phase);
+    profile.end(phase);
+    check(profile.phase("setup") == phase, "profile phase identifier");
+    profile.add(profile.phase("flipping"), 0.5, 10);
+    profile.set_value("memory_total", 1024);
+    profile.set_value("ratio", 0.25);
+    std::stringstream stream;
+    profile.write_json(stream);
+    std::string text = stream.str();
+    check(is_json_object(text), "profile json");
+    check(text.find("\"counters\": false") != std::string::npos, "profile counters");
+    check(text.find("{\"name\": \"setup\", \"calls\": 1, \"seconds\": ") != std::string::npos, "profile phase");
+    check(text.find("{\"name\": \"flipping\", \"calls\": 10, \"seconds\": 0.5}") != std::string::npos,
+          "profile added phase");
+    check(text.find("\"values\": {\"memory_total\": 1024, \"ratio\": 0.25}") != std::string::npos,
+          "profile values");
+
+    // the generation records a phase per layer
+    Profile generation_profile(false);
+    FlipGraph flip_graph;
+    flip_graph.compute(9, true, &generation_profile);
+    stream.str("");
+    generation_profile.write_json(stream);
+    text = stream.str();
+    check(is_json_object(text) && text.find("\"layer 0\"") != std::string::npos
+          && text.find("\"lookup\"") != std::string::npos, "profile generation");
+}
+
+void test_progress() {
+    // without an interval every PROGRESS_CHECK_PERIOD-th expansion reports
+    std::stringstream stream;
+    Progress progress(stream, 0);
+    FlipGraph flip_graph;
+    flip_graph.compute(10, true, nullptr, &progress);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(stream, line)) { lines.push_back(line); }
+    int expected = (int) flip_graph.graph().size() / PROGRESS_CHECK_PERIOD;
+    check((int) lines.size() == expected, "progress reports");
+
+    const char *keys[] = {"seconds", "layer", "frontier", "discovered", "edges", "codes_per_second",
+                          "flips_per_second", "accounted_bytes", "resident_bytes"};
+    bool valid = true;
+    for (const std::string &report : lines) {
+        valid = valid && is_json_object(report);
+        for (const char *key : keys) {
+            valid = valid && report.find("\"" + std::string(key) + "\": ") != std::string::npos;
+        }
+    }
+    check(valid, "progress json");
+}
+
+/* ---------------------------------------------------------------------- *
+ * labeled flip graphs
+ * ---------------------------------------------------------------------- */
+
+void test_labeled(int n) {
+    std::string name = "labeled n=" + std::to_string(n);
+    FlipGraph flip_graph;
+    flip_graph.compute(n);
+    LabeledCounts counts;
+    labeled_counts(flip_graph, counts);
+
+    LabeledCounts explicit_counts;
+    std::vector<uint64_t> layers;
+    explore_labeled(n, explicit_counts, layers);
+
+    uint64_t sum = 0;
+    for (uint64_t layer : layers) { sum += layer; }
+    check(counts.triangulations == explicit_counts.triangulations, name + " triangulations");
+    check(counts.edges == explicit_counts.edges, name + " edges");
+    check(counts.degrees == explicit_counts.degrees, name + " degrees");
+    check(sum == explicit_counts.triangulations, name + " layers");
+}
+
+/* ---------------------------------------------------------------------- *
+ * outerplanar flip graphs
+ * ---------------------------------------------------------------------- */
+
+void test_polygons(int n) {
+    std::string name = "polygons n=" + std::to_string(n);
+    FlipGraph general;
+    general.set_triangulation_class(CLASS_OUTERPLANAR);
+    general.compute(n);
+    FlipGraph polygons;
+    check(polygons.compute_polygons(n), name + " complete");
+    FlipGraph compact;
+    compact.compute_polygons(n, false);
+    check(compact.has_parents() && !compact.stores_codes(), name + " search tree");
+
+    // the graphs are compared by the codes of their triangulations
+    std::map<Code, int> indices;
+    code_indices(general, indices);
+    int size = (int) general.graph().size();
+    check((int) polygons.graph().size() == size, name + " size");
+    if ((int) polygons.graph().size() != size) { return; }
+    std::vector<int> depths;
+    distance_list(polygons.graph(), 0, depths);
+    std::vector<int> flips;
+    std::vector<int> general_flips;
+
+    for (int i = 0; i < size; ++i) {
+        Code code(polygons.code(i));
+        std::map<Code, int>::iterator it = indices.find(code);
+        check(it != indices.end(), name + " code " + std::to_string(i));
+        if (it == indices.end()) { continue; }
+
+        // both engines discover the triangulations in the same order
+        check(it->second == i && polygons.graph()[i] == general.graph()[i], name + " order " + std::to_string(i));
+
+        std::set<int> neighbors;
+        for (int neighbor : polygons.graph()[i]) { neighbors.insert(indices[Code(polygons.code(neighbor))]); }
+        std::set<int> expected(general.graph()[it->second].begin(), general.graph()[it->second].end());
+        check(neighbors == expected, name + " neighbors " + std::to_string(i));
+        check(polygons.automorphisms(i) == general.automorphisms(it->second), name + " automorphisms "
+              + std::to_string(i));
+
+        // the codes rebuilt from the search tree agree with the computed
+        // ones and the search tree is a breadth first search tree
+        check(compact.code(i) == code, name + " rebuilt code " + std::to_string(i));
+        if (i > 0) { check(compact.code(i - 1) != compact.code(i), name + " rebuilt pair " + std::to_string(i)); }
+        compact.flip_sequence(i, flips);
+        check((int) flips.size() == depths[i], name + " flip sequence " + std::to_string(i));
+        general.flip_sequence(i, general_flips);
+        check(flips == general_flips, name + " flips " + std::to_string(i));
+    }
+}
+
+/* ---------------------------------------------------------------------- *
+ * main function
+ * ---------------------------------------------------------------------- */
+
+int main(int argc, char *argv[]) {
+    // writes the triangulations farthest from the canonical triangulation
+    char *option_n = get_cmd_option(argc, argv, "-n");
+    if (option_n) {
+        write_farthest_triangulations(std::stoi(option_n));
+        return 0;
+    }
+
+    for (int n = 4; n <= 9; ++n) { test_code_files(n, CLASS_PLANAR); }
+    for (int n = 4; n <= 11; ++n) { test_code_files(n, CLASS_OUTERPLANAR); }
+    for (int n = 4; n <= 9; ++n) { test_planar_code(n, CLASS_PLANAR); }
+    for (int n = 4; n <= 11; ++n) { test_planar_code(n, CLASS_OUTERPLANAR); }
+    test_invalid_planar_code();
+    test_sampler(12, false);
+    test_sampler(12, true);
+    for (int n = 6; n <= 8; ++n) {
+        test_spectrum(n, CLASS_PLANAR);
+        test_spectrum(n, CLASS_OUTERPLANAR);
+    }
+    test_distance_matrix(10, CLASS_PLANAR);
+    test_distance_matrix(9, CLASS_OUTERPLANAR);
+    test_invalid_distance_matrix();
+    test_two_center(9, CLASS_PLANAR);
+    test_two_center(9, CLASS_OUTERPLANAR);
+    test_profile();
+    test_progress();
+    for (int n = 4; n <= 9; ++n) { test_code_index(n, CLASS_PLANAR); }
+    test_code_index(10, CLASS_OUTERPLANAR);
+    test_queries();
+    test_canonical_codes();
+    test_symmetries();
+    test_flip_distances(9, 3, 1);
+    test_flip_distances(11, 2, 97);
+    test_ball(9, 0, 2, 1);
+    test_ball(10, 17, 3, 4);
+    test_memory_limit(10);
+    for (int n = 4; n <= 8; ++n) { test_labeled(n); }
+    for (int n = 4; n <= 13; ++n) { test_polygons(n); }
+
+    if (failures > 0) {
+        std::cout << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "all checks passed" << std::endl;
     return 0;
 }
 
 /* ---------------------------------------------------------------------- *
  * end of file
- * ---------------------------------------------------------------------- */
\ No newline at end of file
+ * ---------------------------------------------------------------------- */